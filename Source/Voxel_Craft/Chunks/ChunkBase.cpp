@@ -1,6 +1,6 @@
 #include "ChunkBase.h"
 
-#include "Voxel_craft/Utils/FastNoiseLite.h"
+#include "Voxel_Craft/Utils/VoxelWorldGenerator.h"
 #include "ProceduralMeshComponent.h"
 
 
@@ -13,11 +13,6 @@ AChunkBase::AChunkBase()
 	PrimaryActorTick.bCanEverTick = false;
 
 	Mesh = CreateDefaultSubobject<UProceduralMeshComponent>("Mesh");
-	Noise = new FastNoiseLite();
-	BiomeNoise = new FastNoiseLite();
-	RiverNoise = new FastNoiseLite();
-	LakeNoise = new FastNoiseLite();
-	
 
 	// Mesh Settings
 	Mesh->SetCastShadow(false);
@@ -32,51 +27,26 @@ void AChunkBase::BeginPlay()
 {
 	Super::BeginPlay();
 
-	Noise->SetSeed(Seed);
-
-	Noise->SetFrequency(Frequency);
-	Noise->SetNoiseType(FastNoiseLite::NoiseType_Perlin);
-	Noise->SetFractalType(FastNoiseLite::FractalType_FBm);
-	RiverNoise->SetFractalOctaves(4); // Try 3–5
-
-
-	BiomeNoise->SetSeed(Seed + 1);
-	
-	BiomeNoise->SetFrequency(Frequency * 0.2f); // lower frequency for large biome patches
-	BiomeNoise->SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2); // different type = more biome variety
-	BiomeNoise->SetFractalType(FastNoiseLite::FractalType_None);
-	RiverNoise->SetFractalOctaves(4); // Try 3–5
-
-
-	RiverNoise->SetSeed(Seed + 1337); // unique river seed
-	
-	RiverNoise->SetFrequency(0.009f); // low frequency = longer, wider rivers
-	RiverNoise->SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-	RiverNoise->SetFractalType(FastNoiseLite::FractalType_FBm);
-	RiverNoise->SetFractalOctaves(4); // Try 3–5
-
-	LakeNoise->SetSeed(Seed + 42);
-
-	LakeNoise->SetFrequency(0.001f);
-	LakeNoise->SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-	LakeNoise->SetFractalType(FastNoiseLite::FractalType_FBm);
-	LakeNoise->SetFractalOctaves(4); // 3–5 is typical
-
+	// A chunk placed on its own still needs noise, chunks spawned by the world share its generator
+	if (!WorldGenerator)
+	{
+		WorldGenerator = MakeShared<FVoxelWorldGenerator>(Seed, Frequency, ChunkSize);
+	}
 
 	Setup();
 	
-	GenerateHeightMap();
+	if (!bVoxelDataReady)
+	{
+		GenerateHeightMap();
+	}
 	
+	// Chunks spawned by the world skip this, their first mesh is built once their neighbors are loaded
 	if (bShouldGenerateInitialMesh)
 	{
 		ClearMesh();
 		GenerateMesh();
 		ApplyMesh();
 	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Skipped initial mesh generation because bShouldGenerateInitialMesh is false"));
-	}
 }
 
 void AChunkBase::GenerateHeightMap()
@@ -151,12 +121,16 @@ void AChunkBase::ModifyVoxel(const FIntVector Position, const EBlock Block)
 
 	ModifyVoxelData(Position,Block);
 
+	RemeshAfterEdit(Position);
+}
+
+void AChunkBase::RemeshAfterEdit(const FIntVector& Position)
+{
 	ClearMesh();
 
 	GenerateMesh();
 
 	ApplyMesh();
-	
 }
 void AChunkBase::UpdateMesh()
 {
@@ -9,7 +9,7 @@
 
 #include "ChunkBase.generated.h"
 
-class FastNoiseLite;
+class FVoxelWorldGenerator;
 class UProceduralMeshComponent;
 
 UCLASS(Abstract)
@@ -38,6 +38,9 @@ public:
 	
 	void SetSeed(int32 InSeed) { Seed = InSeed; }
 
+	// Shares the world's generator, chunks spawned without one build their own from Seed and Frequency
+	void SetWorldGenerator(const TSharedPtr<const FVoxelWorldGenerator>& InGenerator) { WorldGenerator = InGenerator; }
+
 	bool bShouldGenerateInitialMesh = true;
 	bool bHasBeenMeshedWithNeighbors = false;
 
@@ -53,12 +56,16 @@ protected:
 	
 	virtual void ModifyVoxelData(const FIntVector Position, const EBlock Block) PURE_VIRTUAL(AChunkBase::ModifyVoxelData);
 
+	// Rebuilds the mesh after ModifyVoxel changed the block at Position, the whole chunk by default
+	virtual void RemeshAfterEdit(const FIntVector& Position);
+
 	int32 Seed;
+
+	// Set when voxels were generated up front (e.g. on a worker thread) and BeginPlay must not regenerate them
+	bool bVoxelDataReady = false;
+
 	TObjectPtr<UProceduralMeshComponent> Mesh;
-	FastNoiseLite* Noise;
-	FastNoiseLite* BiomeNoise;
-	FastNoiseLite* RiverNoise;
-	FastNoiseLite* LakeNoise;
+	TSharedPtr<const FVoxelWorldGenerator> WorldGenerator;
 	FChunkMeshData MeshData;
 	int VertexCount = 0;
 
@@ -67,9 +74,10 @@ protected:
 
 	UPROPERTY()
 	TArray<int32> VertexCountPerMat;
+
+	virtual void ApplyMesh() const;
 	
 private:
-	void ApplyMesh() const;
 	void ClearMesh();
 	virtual void GenerateHeightMap();
 };
\ No newline at end of file
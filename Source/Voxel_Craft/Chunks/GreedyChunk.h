@@ -5,83 +5,119 @@
 #include "Voxel_craft/Utils/WaterSimulator.h"
 #include "ChunkBase.h"
 #include "Voxel_craft/Utils/Enums.h"
+#include "Voxel_Craft/Utils/ChunkVoxelData.h"
+#include "Voxel_Craft/Utils/GreedyMesher.h"
+#include "Tasks/Task.h"
+#include "Containers/StaticArray.h"
 
 #include "GreedyChunk.generated.h"
 
-class FastNoiseLite;
+class FChunkRegistry;
 class UProceduralMeshComponent;
 
-USTRUCT()
-struct FBiomeNoiseSettings
-{
-	GENERATED_BODY()
-
-	UPROPERTY()
-	float Frequency = 0.01f;
-
-	UPROPERTY()
-	float Amplitude = 1.0f;
-
-	UPROPERTY()
-	float Offset = 0.0f;
-};
-
 UCLASS()
 class AGreedyChunk final : public AChunkBase
 {
 	GENERATED_BODY()
 
-	struct FMask
-	{
-		EBlock Block;
-		int Normal;
-	};
 public:
 	void InitializeChunkOrigin(const FIntVector& Coords);
 
 	EBlock GetBlock(FIntVector Index) const;
 	void SetWaterSimulator(FWaterSimulator* InSimulator);
+	void SetChunkRegistry(FChunkRegistry* InRegistry) { ChunkRegistry = InRegistry; }
+	void SetVoxelData(FChunkVoxelData&& InVoxels);
 	bool IsInsideChunk(const FIntVector& Position) const;
 	EBlock GetBlockWorld(const FIntVector& WorldPosition) const;
 	uint8 GetMeta(const FIntVector& Position) const;
-	static AGreedyChunk* GetChunkAt(const FIntVector& WorldBlockPosition, const FIntVector& ChunkPosition);
 	void SetBlockAt(const FIntVector& Position, EBlock BlockType);
 	void SetMeta(const FIntVector& Position, uint8 MetaValue);
 	virtual void UpdateMesh() override;
 
-	static TMap<FIntVector, AGreedyChunk*> LoadedChunks;
+	// Copies this chunk's blocks and its neighbors' border slabs for meshing off the game thread
+	FChunkMeshSnapshot CreateMeshSnapshot() const;
+
+	// Same, but only copies what meshing the layers [ZBegin, ZEnd) reads
+	FChunkMeshSnapshot CreateMeshSnapshot(int32 ZBegin, int32 ZEnd) const;
+
+	// Meshes a snapshot taken now on a worker thread, the result is handed back through ApplyMeshData
+	UE::Tasks::TTask<TArray<FChunkMeshData>> LaunchMeshTask() const;
+	void ApplyMeshData(TArray<FChunkMeshData>&& InMeshPerMaterial);
+
+	// Parks an unloaded chunk: hides it and drops its voxels and mesh, but keeps the actor and its mesh component
+	void ReturnToPool();
+
+	// Brings a pooled chunk back at a new chunk coordinate with freshly generated voxels
+	void ReuseAt(const FIntVector& Coords, FChunkVoxelData&& InVoxels);
+
+	// Queues a section for RebuildDirtySections
+	void MarkSectionDirty(int32 Section);
+
+	// Remeshes and re-uploads only the sections marked dirty, on the game thread. Before the first full mesh lands they are kept for ApplyMeshData
+	void RebuildDirtySections();
+
+	EMeshingAlgorithm MeshingAlgorithm = EMeshingAlgorithm::Scalar;
+
+	const FIntVector& GetChunkCoord() const { return ChunkCoord; }
+
+	// The block filling the whole chunk, Null when it is mixed
+	EBlock GetUniformBlock() const { return Voxels.GetUniformBlock(); }
+
+	// Loaded chunk one step away along a single axis (e.g. (0, -1, 0)), nullptr when there is none
+	AGreedyChunk* GetNeighbor(const FIntVector& Offset) const { return Neighbors[GetNeighborFace(Offset)]; }
+
+	// Links this chunk and its loaded neighbors to each other, call once it is in the chunk registry
+	void LinkNeighbors();
+
+	// Clears the links both ways, call when the chunk is unloaded
+	void UnlinkNeighbors();
 protected:
 	virtual void Setup() override;
-	static float GetFractalNoise2D(FastNoiseLite* Noise, float X, float Y, float Frequency, int Octaves, float Persistence);
 	virtual void Generate2DHeightMap(FVector Position) override;
 	virtual void Generate3DHeightMap(FVector Position) override;
 	virtual void GenerateMesh() override;
 	virtual void ModifyVoxelData(FIntVector Position, EBlock Block) override;
+	virtual void RemeshAfterEdit(const FIntVector& Position) override;
+	virtual void ApplyMesh() const override;
 	EBlock GetBlockWithNeighbors(const FIntVector& Pos) const;
 	
 private:
 
 	FWaterSimulator* WaterSimulator = nullptr;
+
+	// Loaded chunks of the world this chunk belongs to, used to reach neighbors
+	FChunkRegistry* ChunkRegistry = nullptr;
 	
-	TArray<EBlock> Blocks;
-	
-	TArray<uint8> BlockMeta;
-	
-	FastNoiseLite* BiomeNoise;
+	FChunkVoxelData Voxels;
 	
 	FIntVector ChunkOrigin;
+
+	FIntVector ChunkCoord;
+
+	TSet<int32> DirtySections;
+
+	// Face neighbors ordered -X, +X, -Y, +Y, -Z, +Z, so a face's opposite is Face ^ 1
+	TStaticArray<AGreedyChunk*, 6> Neighbors = TStaticArray<AGreedyChunk*, 6>(InPlace, nullptr);
+
+	static int32 GetNeighborFace(const FIntVector& Offset)
+	{
+		return Offset.X != 0 ? (Offset.X > 0) : Offset.Y != 0 ? 2 + (Offset.Y > 0) : 4 + (Offset.Z > 0);
+	}
+
+	// Walks the neighbor links to the chunk holding a position outside this one and makes LocalPos local to it
+	AGreedyChunk* FindChunkHolding(FIntVector& LocalPos) const;
 	
-	TMap<EBiomeType, FBiomeNoiseSettings> BiomeSettingsMap;
-	
-	UPROPERTY()
-	TSet<FIntVector> OriginalTopCactusBlocks;
-	
-	void CreateQuad(FMask Mask, FIntVector AxisMask, int Width, int Height, FIntVector V1, FIntVector V2, FIntVector V3, FIntVector V4);
 	int GetBlockIndex(int X, int Y, int Z) const;
+	AGreedyChunk* FindLoadedChunk(const FIntVector& Coords) const;
+
+	// Block filling the neighbor at Offset when it was elided, Null when it has an actor or isn't loaded
+	EBlock GetElidedNeighborBlock(const FIntVector& Offset) const;
+
+	// Block filling a section of the neighbor at Offset: its uniform block (Null when mixed), an elided neighbor's block, or air when nothing is loaded
+	EBlock GetNeighborSectionBlock(const FIntVector& Offset, int32 Section) const;
 	bool IsTopmostCactusBlock(const FIntVector& BlockPos) const;
-	static bool CompareMask(FMask M1, FMask M2);
-	static int32 GetMaterialIndex(EBlock Block, const FVector& Normal);
-	int GetTextureIndex(EBlock Block, const FVector& Normal, const FIntVector& BlockPos) const;
-	void SpawnTreeAt(int x, int y, int z, const FRandomStream& TreeRand);
-	void SpawnCactusAt(int x, int y, int z);
+
+	// Mesh section index of a chunk section's material slot, each chunk section owns MaterialCount of them
+	static int32 GetMeshSectionIndex(const int32 Section, const int32 Material) { return Section * FGreedyMesher::MaterialCount + Material; }
+	void ApplySectionMesh(int32 Section) const;
 };
\ No newline at end of file
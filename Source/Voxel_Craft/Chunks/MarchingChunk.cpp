@@ -3,7 +3,7 @@
 
 #include "MarchingChunk.h"
 
-#include "Voxel_Craft/Utils/FastNoiseLite.h"
+#include "Voxel_Craft/Utils/VoxelWorldGenerator.h"
 
 void AMarchingChunk::Setup()
 {
@@ -13,6 +13,8 @@ void AMarchingChunk::Setup()
 
 void AMarchingChunk::Generate2DHeightMap(const FVector Position)
 {
+	const FastNoiseLite& TerrainNoise = WorldGenerator->GetTerrainNoise();
+
 	for (int x = 0; x <= ChunkSize.X; x++)
 	{
 		for (int y = 0; y <= ChunkSize.Y; y++)
@@ -20,7 +22,7 @@ void AMarchingChunk::Generate2DHeightMap(const FVector Position)
 			const float Xpos = x + Position.X;
 			const float ypos = y + Position.Y;
 			
-			const int Height = FMath::Clamp(FMath::RoundToInt((Noise->GetNoise(Xpos, ypos) + 1) * ChunkSize.Z / 2), 0, ChunkSize.Z);
+			const int Height = FMath::Clamp(FMath::RoundToInt((TerrainNoise.GetNoise(Xpos, ypos) + 1) * ChunkSize.Z / 2), 0, ChunkSize.Z);
 
 			for (int z = 0; z < Height; z++)
 			{
@@ -36,17 +38,9 @@ void AMarchingChunk::Generate2DHeightMap(const FVector Position)
 }
 
 void AMarchingChunk::Generate3DHeightMap(const FVector Position)
-{	
-	for (int x = 0; x <= ChunkSize.X; ++x)
-	{
-		for (int y = 0; y <= ChunkSize.Y; ++y)
-		{
-			for (int z = 0; z <= ChunkSize.Z; ++z)
-			{
-				Voxels[GetVoxelIndex(x,y,z)] = Noise->GetNoise(x + Position.X, y + Position.Y, z + Position.Z);	
-			}
-		}
-	}
+{
+	// One corner past the chunk on each axis, laid out like GetVoxelIndex
+	WorldGenerator->GetDensityGrid(Position, ChunkSize + FIntVector(1, 1, 1), Voxels);
 }
 
 void AMarchingChunk::GenerateMesh()
@@ -3,7 +3,7 @@
 
 #include "NaiveChunk.h"
 
-#include "Voxel_Craft/Utils/FastNoiseLite.h"
+#include "Voxel_Craft/Utils/VoxelWorldGenerator.h"
 
 void ANaiveChunk::Setup()
 {
@@ -13,6 +13,8 @@ void ANaiveChunk::Setup()
 
 void ANaiveChunk::Generate2DHeightMap(const FVector Position)
 {
+	const FastNoiseLite& TerrainNoise = WorldGenerator->GetTerrainNoise();
+
 	for (int x = 0; x < ChunkSize.X; x++)
 	{
 		for (int y = 0; y < ChunkSize.Y; y++)
@@ -20,7 +22,7 @@ void ANaiveChunk::Generate2DHeightMap(const FVector Position)
 			const float Xpos = x + Position.X;
 			const float ypos = y + Position.Y;
 			
-			const int Height = FMath::Clamp(FMath::RoundToInt((Noise->GetNoise(Xpos, ypos) + 1) * ChunkSize.Z / 2), 0, ChunkSize.Z);
+			const int Height = FMath::Clamp(FMath::RoundToInt((TerrainNoise.GetNoise(Xpos, ypos) + 1) * ChunkSize.Z / 2), 0, ChunkSize.Z);
 
 			for (int z = 0; z < Height; z++)
 			{
@@ -38,24 +40,13 @@ void ANaiveChunk::Generate2DHeightMap(const FVector Position)
 
 void ANaiveChunk::Generate3DHeightMap(const FVector Position)
 {
-	for (int x = 0; x < ChunkSize.X; ++x)
-	{
-		for (int y = 0; y < ChunkSize.Y; ++y)
-		{
-			for (int z = 0; z < ChunkSize.Z; ++z)
-			{
-				const auto NoiseValue = Noise->GetNoise(x + Position.X, y + Position.Y, z + Position.Z);
+	// Density is laid out like Blocks
+	TArray<float> Density;
+	WorldGenerator->GetDensityGrid(Position, ChunkSize, Density);
 
-				if (NoiseValue >= 0)
-				{
-					Blocks[GetBlockIndex(x, y, z)] = EBlock::Air;
-				}
-				else
-				{
-					Blocks[GetBlockIndex(x, y, z)] = EBlock::Stone;
-				}
-			}
-		}
+	for (int32 Index = 0; Index < Density.Num(); ++Index)
+	{
+		Blocks[Index] = Density[Index] >= 0 ? EBlock::Air : EBlock::Stone;
 	}
 }
 
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Voxel_Craft/Utils/Enums.h"
+#include "Voxel_Craft/Utils/PalettedStorage.h"
+
+/**
+ * FChunkSection
+ * SectionHeight layers of a chunk. A section filled with a single block (open sky, solid
+ * stone) keeps zero bits per voxel, so it costs no allocation beyond the section itself.
+ */
+struct FChunkSection
+{
+	TPalettedStorage<EBlock> Blocks;
+
+	TPalettedStorage<uint8> BlockMeta;
+};
+
+/**
+ * FChunkVoxelData
+ * Plain voxel buffer for a single chunk. Holds no UObject references so it can be
+ * filled on a worker thread and handed to a chunk actor once it is ready. Blocks and meta
+ * are palette compressed per vertical section, so go through the accessors rather than
+ * the storage directly.
+ */
+struct FChunkVoxelData
+{
+	static constexpr int32 SectionHeight = 16;
+
+	FIntVector Size = FIntVector::ZeroValue;
+
+	TArray<FChunkSection> Sections;
+
+	// Cactus tops placed by generation, used for the top face texture
+	TSet<FIntVector> OriginalTopCactusBlocks;
+
+	// Sizes the buffer and fills it with Block
+	void Init(const FIntVector& InSize, EBlock Block = EBlock::Air);
+
+	int32 GetBlockIndex(int X, int Y, int Z) const;
+
+	bool IsInside(const FIntVector& LocalPos) const;
+
+	int32 GetSectionCount() const { return Sections.Num(); }
+
+	EBlock GetBlock(int32 Index) const;
+	void SetBlock(int32 Index, EBlock Block);
+
+	uint8 GetMeta(int32 Index) const;
+	void SetMeta(int32 Index, uint8 Meta);
+
+	// Decodes Count blocks from Index on, the range must stay inside one section (e.g. an X row)
+	void GetBlockRange(int32 Index, int32 Count, EBlock* Out) const;
+
+	// Writes Count blocks from Index on, the range must stay inside one section (e.g. a Z layer)
+	void SetBlockRange(int32 Index, int32 Count, const EBlock* Blocks);
+
+	// Sets Count blocks from Index on to Block. May span sections, fully covered ones become uniform
+	void FillBlocks(int32 Index, int32 Count, EBlock Block);
+
+	// The block filling a whole section, or Null when the section is mixed
+	EBlock GetUniformBlock(int32 Section) const;
+
+	// The block filling the whole chunk, or Null when it is mixed
+	EBlock GetUniformBlock() const;
+
+	// Shrinks every palette to the values still in use, call once a bulk write is done
+	void Compact();
+
+	// Lowest and highest layer holding anything but air, Min > Max when the chunk is empty
+	int32 GetOccupiedMinZ() const { return OccupiedMinZ; }
+	int32 GetOccupiedMaxZ() const { return OccupiedMaxZ; }
+
+	// One past the highest layer holding anything but air in column X, Y, 0 when it is all air
+	int32 GetColumnTop(int X, int Y) const { return ColumnTops[Y * Size.X + X]; }
+
+private:
+	// Voxels in one full section, the last section may be shorter
+	int32 SectionVolume = 0;
+
+	// Occupied bounds, kept up to date by every write. They only ever grow, so blocks removed since still count
+	TArray<int32> ColumnTops;
+	int32 OccupiedMinZ = 0;
+	int32 OccupiedMaxZ = -1;
+
+	// Grows the occupied bounds to cover layers Z0 to Z1 of every column from Column0 to Column1
+	void MarkOccupied(int32 Z0, int32 Z1, int32 Column0, int32 Column1);
+};
+
+inline void FChunkVoxelData::Init(const FIntVector& InSize, const EBlock Block)
+{
+	Size = InSize;
+	SectionVolume = Size.X * Size.Y * SectionHeight;
+
+	Sections.Reset();
+	Sections.SetNum(FMath::DivideAndRoundUp(Size.Z, SectionHeight));
+	for (int32 Section = 0; Section < Sections.Num(); ++Section)
+	{
+		const int32 Count = Size.X * Size.Y * FMath::Min(SectionHeight, Size.Z - Section * SectionHeight);
+		Sections[Section].Blocks.Init(Count, Block);
+		Sections[Section].BlockMeta.Init(Count, 0);
+	}
+
+	OriginalTopCactusBlocks.Empty();
+
+	const bool bEmpty = Block == EBlock::Air;
+	ColumnTops.Init(bEmpty ? 0 : Size.Z, Size.X * Size.Y);
+	OccupiedMinZ = bEmpty ? Size.Z : 0;
+	OccupiedMaxZ = bEmpty ? -1 : Size.Z - 1;
+}
+
+inline void FChunkVoxelData::MarkOccupied(const int32 Z0, const int32 Z1, const int32 Column0, const int32 Column1)
+{
+	OccupiedMinZ = FMath::Min(OccupiedMinZ, Z0);
+	OccupiedMaxZ = FMath::Max(OccupiedMaxZ, Z1);
+
+	for (int32 Column = Column0; Column <= Column1; ++Column)
+	{
+		ColumnTops[Column] = FMath::Max(ColumnTops[Column], Z1 + 1);
+	}
+}
+
+inline int32 FChunkVoxelData::GetBlockIndex(const int X, const int Y, const int Z) const
+{
+	return Z * Size.Y * Size.X + Y * Size.X + X;
+}
+
+inline bool FChunkVoxelData::IsInside(const FIntVector& LocalPos) const
+{
+	return LocalPos.X >= 0 && LocalPos.X < Size.X &&
+		   LocalPos.Y >= 0 && LocalPos.Y < Size.Y &&
+		   LocalPos.Z >= 0 && LocalPos.Z < Size.Z;
+}
+
+inline EBlock FChunkVoxelData::GetBlock(const int32 Index) const
+{
+	const int32 Section = Index / SectionVolume;
+	return Sections[Section].Blocks.Get(Index - Section * SectionVolume);
+}
+
+inline void FChunkVoxelData::SetBlock(const int32 Index, const EBlock Block)
+{
+	const int32 Section = Index / SectionVolume;
+	Sections[Section].Blocks.Set(Index - Section * SectionVolume, Block);
+
+	if (Block != EBlock::Air)
+	{
+		const int32 LayerSize = Size.X * Size.Y;
+		const int32 Z = Index / LayerSize;
+		const int32 Column = Index - Z * LayerSize;
+		MarkOccupied(Z, Z, Column, Column);
+	}
+}
+
+inline uint8 FChunkVoxelData::GetMeta(const int32 Index) const
+{
+	const int32 Section = Index / SectionVolume;
+	return Sections[Section].BlockMeta.Get(Index - Section * SectionVolume);
+}
+
+inline void FChunkVoxelData::SetMeta(const int32 Index, const uint8 Meta)
+{
+	const int32 Section = Index / SectionVolume;
+	Sections[Section].BlockMeta.Set(Index - Section * SectionVolume, Meta);
+}
+
+inline void FChunkVoxelData::GetBlockRange(const int32 Index, const int32 Count, EBlock* Out) const
+{
+	const int32 Section = Index / SectionVolume;
+	Sections[Section].Blocks.GetRange(Index - Section * SectionVolume, Count, Out);
+}
+
+inline void FChunkVoxelData::SetBlockRange(const int32 Index, const int32 Count, const EBlock* Blocks)
+{
+	const int32 Section = Index / SectionVolume;
+	Sections[Section].Blocks.SetRange(Index - Section * SectionVolume, Count, Blocks);
+
+	const int32 LayerSize = Size.X * Size.Y;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (Blocks[i] == EBlock::Air) continue;
+
+		const int32 Z = (Index + i) / LayerSize;
+		const int32 Column = Index + i - Z * LayerSize;
+		MarkOccupied(Z, Z, Column, Column);
+	}
+}
+
+inline void FChunkVoxelData::FillBlocks(int32 Index, int32 Count, const EBlock Block)
+{
+	if (Count <= 0) return;
+
+	if (Block != EBlock::Air)
+	{
+		// Every column the range passes through is counted up to the range's last layer
+		const int32 LayerSize = Size.X * Size.Y;
+		const int32 Z0 = Index / LayerSize;
+		const int32 Z1 = (Index + Count - 1) / LayerSize;
+		const bool bOneLayer = Z0 == Z1;
+		MarkOccupied(Z0, Z1, bOneLayer ? Index - Z0 * LayerSize : 0, bOneLayer ? Index + Count - 1 - Z0 * LayerSize : LayerSize - 1);
+	}
+
+	while (Count > 0)
+	{
+		const int32 Section = Index / SectionVolume;
+		const int32 SectionStart = Index - Section * SectionVolume;
+		const int32 SectionCount = FMath::Min(Count, Sections[Section].Blocks.Num() - SectionStart);
+
+		Sections[Section].Blocks.Fill(SectionStart, SectionCount, Block);
+
+		Index += SectionCount;
+		Count -= SectionCount;
+	}
+}
+
+inline EBlock FChunkVoxelData::GetUniformBlock(const int32 Section) const
+{
+	const TPalettedStorage<EBlock>& SectionBlocks = Sections[Section].Blocks;
+	return SectionBlocks.IsUniform() ? SectionBlocks.Get(0) : EBlock::Null;
+}
+
+inline EBlock FChunkVoxelData::GetUniformBlock() const
+{
+	if (Sections.IsEmpty()) return EBlock::Null;
+
+	const EBlock Block = GetUniformBlock(0);
+	for (int32 Section = 1; Section < Sections.Num() && Block != EBlock::Null; ++Section)
+	{
+		if (GetUniformBlock(Section) != Block) return EBlock::Null;
+	}
+	return Block;
+}
+
+inline void FChunkVoxelData::Compact()
+{
+	for (FChunkSection& Section : Sections)
+	{
+		Section.Blocks.Compact();
+		Section.BlockMeta.Compact();
+	}
+}
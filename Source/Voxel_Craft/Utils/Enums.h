@@ -19,6 +19,13 @@ enum class EGenerationType : uint8
 	GT_2D UMETA(DisplayName = "2D"),
 };
 
+UENUM(BlueprintType)
+enum class EMeshingAlgorithm : uint8
+{
+	Scalar	UMETA(DisplayName = "Scalar"),
+	Binary	UMETA(DisplayName = "Binary"),
+};
+
 UENUM(BlueprintType)
 enum class EBiomeType : uint8
 {
@@ -29,3 +36,17 @@ enum class EBiomeType : uint8
 	Mountain	UMETA(DisplayName = "Mountain"),
 	Snowy		UMETA(DisplayName = "Snowy")
 };
+
+// Steps of 2D generation in the order they run, as flags so chunks can skip some. Height always runs, every other stage reads it
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EGenerationStage : uint8
+{
+	None		= 0			UMETA(Hidden),
+	Height		= 1 << 0	UMETA(DisplayName = "Height & Biome"),
+	Fill		= 1 << 1	UMETA(DisplayName = "Fill"),
+	WaterBodies	= 1 << 2	UMETA(DisplayName = "Water Bodies"),
+	Carving		= 1 << 3	UMETA(DisplayName = "Carving"),
+	Decoration	= 1 << 4	UMETA(DisplayName = "Decoration"),
+	All			= Height | Fill | WaterBodies | Carving | Decoration UMETA(Hidden)
+};
+ENUM_CLASS_FLAGS(EGenerationStage)
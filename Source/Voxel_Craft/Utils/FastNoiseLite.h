@@ -52,6 +52,19 @@
 
 #include <cmath>
 
+// 4 lane SIMD for the batched grid API, the scalar path is used where neither is available
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FNL_SIMD_SSE2
+#include <emmintrin.h>
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define FNL_SIMD_SSE41
+#include <smmintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define FNL_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 class FastNoiseLite
 {
 public:
@@ -293,7 +306,7 @@ public:
     /// Noise output bounded between -1...1
     /// </returns>
     template <typename FNfloat>
-    float GetNoise(FNfloat x, FNfloat y)
+    float GetNoise(FNfloat x, FNfloat y) const
     {
         Arguments_must_be_floating_point_values<FNfloat>();
 
@@ -319,7 +332,7 @@ public:
     /// Noise output bounded between -1...1
     /// </returns>
     template <typename FNfloat>
-    float GetNoise(FNfloat x, FNfloat y, FNfloat z)
+    float GetNoise(FNfloat x, FNfloat y, FNfloat z) const
     {
         Arguments_must_be_floating_point_values<FNfloat>();
 
@@ -348,7 +361,7 @@ public:
     /// noise = GetNoise(x, y)</code>
     /// </example>
     template <typename FNfloat>
-    void DomainWarp(FNfloat& x, FNfloat& y)
+    void DomainWarp(FNfloat& x, FNfloat& y) const
     {
         Arguments_must_be_floating_point_values<FNfloat>();
 
@@ -375,7 +388,7 @@ public:
     /// noise = GetNoise(x, y, z)</code>
     /// </example>
     template <typename FNfloat>
-    void DomainWarp(FNfloat& x, FNfloat& y, FNfloat& z)
+    void DomainWarp(FNfloat& x, FNfloat& y, FNfloat& z) const
     {
         Arguments_must_be_floating_point_values<FNfloat>();
 
@@ -393,6 +406,87 @@ public:
         }
     }
 
+    /// <summary>
+    /// 2D noise over a regular lattice using current settings
+    /// </summary>
+    /// <remarks>
+    /// out[iy * xCount + ix] = GetNoise(xStart + ix * xStep, yStart + iy * yStep)
+    /// Perlin and OpenSimplex2 with no fractal or FBm are evaluated 4 points at a time
+    /// where SSE2 or NEON is available, everything else falls back to GetNoise per point
+    /// </remarks>
+    void GetNoiseGrid2D(float* out, float xStart, float yStart, float xStep, float yStep, int xCount, int yCount) const
+    {
+        for (int iy = 0; iy < yCount; iy++)
+        {
+            float y = yStart + iy * yStep;
+            float* row = out + iy * xCount;
+            int ix = 0;
+
+#if defined(FNL_SIMD_SSE2) || defined(FNL_SIMD_NEON)
+            if (CanBatchNoise2D())
+            {
+                for (; ix + 4 <= xCount; ix += 4)
+                {
+                    Simd::f32 xv = Simd::Add(Simd::Set(xStart), Simd::Mul(Simd::ToFloat(Simd::Add(Simd::Set(ix), Simd::LaneIndex())), Simd::Set(xStep)));
+                    Simd::f32 yv = Simd::Set(y);
+
+                    TransformNoiseCoordinate4(xv, yv);
+                    Simd::Store(row + ix, GenNoise4(xv, yv));
+                }
+            }
+#endif
+            for (; ix < xCount; ix++)
+            {
+                row[ix] = GetNoise(xStart + ix * xStep, y);
+            }
+        }
+    }
+
+    /// <summary>
+    /// 3D noise over a regular lattice using current settings
+    /// </summary>
+    /// <remarks>
+    /// out[(iz * yCount + iy) * xCount + ix] = GetNoise(xStart + ix * xStep, yStart + iy * yStep, zStart + iz * zStep)
+    /// Perlin with no 3D rotation and no fractal or FBm is evaluated 4 points at a time
+    /// where SSE2 or NEON is available, everything else falls back to GetNoise per point
+    /// </remarks>
+    void GetNoiseGrid3D(float* out, float xStart, float yStart, float zStart, float xStep, float yStep, float zStep, int xCount, int yCount, int zCount) const
+    {
+        for (int iz = 0; iz < zCount; iz++)
+        {
+            float z = zStart + iz * zStep;
+
+            for (int iy = 0; iy < yCount; iy++)
+            {
+                float y = yStart + iy * yStep;
+                float* row = out + (iz * yCount + iy) * xCount;
+                int ix = 0;
+
+#if defined(FNL_SIMD_SSE2) || defined(FNL_SIMD_NEON)
+                if (CanBatchNoise3D())
+                {
+                    for (; ix + 4 <= xCount; ix += 4)
+                    {
+                        Simd::f32 xv = Simd::Add(Simd::Set(xStart), Simd::Mul(Simd::ToFloat(Simd::Add(Simd::Set(ix), Simd::LaneIndex())), Simd::Set(xStep)));
+                        Simd::f32 yv = Simd::Set(y);
+                        Simd::f32 zv = Simd::Set(z);
+
+                        // Only TransformType3D_None is batched, so the transform is the frequency alone
+                        xv = Simd::Mul(xv, Simd::Set(mFrequency));
+                        yv = Simd::Mul(yv, Simd::Set(mFrequency));
+                        zv = Simd::Mul(zv, Simd::Set(mFrequency));
+                        Simd::Store(row + ix, GenNoise4(xv, yv, zv));
+                    }
+                }
+#endif
+                for (; ix < xCount; ix++)
+                {
+                    row[ix] = GetNoise(xStart + ix * xStep, y, z);
+                }
+            }
+        }
+    }
+
 private:
     template <typename T>
     struct Arguments_must_be_floating_point_values;
@@ -526,7 +620,7 @@ private:
     }
 
 
-    float GradCoord(int seed, int xPrimed, int yPrimed, float xd, float yd)
+    float GradCoord(int seed, int xPrimed, int yPrimed, float xd, float yd) const
     {
         int hash = Hash(seed, xPrimed, yPrimed);
         hash ^= hash >> 15;
@@ -539,7 +633,7 @@ private:
     }
 
 
-    float GradCoord(int seed, int xPrimed, int yPrimed, int zPrimed, float xd, float yd, float zd)
+    float GradCoord(int seed, int xPrimed, int yPrimed, int zPrimed, float xd, float yd, float zd) const
     {
         int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
         hash ^= hash >> 15;
@@ -553,7 +647,7 @@ private:
     }
 
 
-    void GradCoordOut(int seed, int xPrimed, int yPrimed, float& xo, float& yo)
+    void GradCoordOut(int seed, int xPrimed, int yPrimed, float& xo, float& yo) const
     {
         int hash = Hash(seed, xPrimed, yPrimed) & (255 << 1);
 
@@ -562,7 +656,7 @@ private:
     }
 
 
-    void GradCoordOut(int seed, int xPrimed, int yPrimed, int zPrimed, float& xo, float& yo, float& zo)
+    void GradCoordOut(int seed, int xPrimed, int yPrimed, int zPrimed, float& xo, float& yo, float& zo) const
     {
         int hash = Hash(seed, xPrimed, yPrimed, zPrimed) & (255 << 2);
 
@@ -572,7 +666,7 @@ private:
     }
 
 
-    void GradCoordDual(int seed, int xPrimed, int yPrimed, float xd, float yd, float& xo, float& yo)
+    void GradCoordDual(int seed, int xPrimed, int yPrimed, float xd, float yd, float& xo, float& yo) const
     {
         int hash = Hash(seed, xPrimed, yPrimed);
         int index1 = hash & (127 << 1);
@@ -590,7 +684,7 @@ private:
     }
 
 
-    void GradCoordDual(int seed, int xPrimed, int yPrimed, int zPrimed, float xd, float yd, float zd, float& xo, float& yo, float& zo)
+    void GradCoordDual(int seed, int xPrimed, int yPrimed, int zPrimed, float xd, float yd, float zd, float& xo, float& yo, float& zo) const
     {
         int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
         int index1 = hash & (63 << 2);
@@ -614,7 +708,7 @@ private:
     // Generic noise gen
 
     template <typename FNfloat>
-    float GenNoiseSingle(int seed, FNfloat x, FNfloat y)
+    float GenNoiseSingle(int seed, FNfloat x, FNfloat y) const
     {
         switch (mNoiseType)
         {
@@ -636,7 +730,7 @@ private:
     }
 
     template <typename FNfloat>
-    float GenNoiseSingle(int seed, FNfloat x, FNfloat y, FNfloat z)
+    float GenNoiseSingle(int seed, FNfloat x, FNfloat y, FNfloat z) const
     {
         switch (mNoiseType)
         {
@@ -661,7 +755,7 @@ private:
     // Noise Coordinate Transforms (frequency, and possible skew or rotation)
 
     template <typename FNfloat>
-    void TransformNoiseCoordinate(FNfloat& x, FNfloat& y)
+    void TransformNoiseCoordinate(FNfloat& x, FNfloat& y) const
     {
         x *= mFrequency;
         y *= mFrequency;
@@ -684,7 +778,7 @@ private:
     }
 
     template <typename FNfloat>
-    void TransformNoiseCoordinate(FNfloat& x, FNfloat& y, FNfloat& z)
+    void TransformNoiseCoordinate(FNfloat& x, FNfloat& y, FNfloat& z) const
     {
         x *= mFrequency;
         y *= mFrequency;
@@ -755,7 +849,7 @@ private:
     // Domain Warp Coordinate Transforms
 
     template <typename FNfloat>
-    void TransformDomainWarpCoordinate(FNfloat& x, FNfloat& y)
+    void TransformDomainWarpCoordinate(FNfloat& x, FNfloat& y) const
     {
         switch (mDomainWarpType)
         {
@@ -775,7 +869,7 @@ private:
     }
 
     template <typename FNfloat>
-    void TransformDomainWarpCoordinate(FNfloat& x, FNfloat& y, FNfloat& z)
+    void TransformDomainWarpCoordinate(FNfloat& x, FNfloat& y, FNfloat& z) const
     {
         switch (mWarpTransformType3D)
         {
@@ -842,7 +936,7 @@ private:
     // Fractal FBm
 
     template <typename FNfloat>
-    float GenFractalFBm(FNfloat x, FNfloat y)
+    float GenFractalFBm(FNfloat x, FNfloat y) const
     {
         int seed = mSeed;
         float sum = 0;
@@ -863,7 +957,7 @@ private:
     }
 
     template <typename FNfloat>
-    float GenFractalFBm(FNfloat x, FNfloat y, FNfloat z)
+    float GenFractalFBm(FNfloat x, FNfloat y, FNfloat z) const
     {
         int seed = mSeed;
         float sum = 0;
@@ -888,7 +982,7 @@ private:
     // Fractal Ridged
 
     template <typename FNfloat>
-    float GenFractalRidged(FNfloat x, FNfloat y)
+    float GenFractalRidged(FNfloat x, FNfloat y) const
     {
         int seed = mSeed;
         float sum = 0;
@@ -909,7 +1003,7 @@ private:
     }
 
     template <typename FNfloat>
-    float GenFractalRidged(FNfloat x, FNfloat y, FNfloat z)
+    float GenFractalRidged(FNfloat x, FNfloat y, FNfloat z) const
     {
         int seed = mSeed;
         float sum = 0;
@@ -934,7 +1028,7 @@ private:
     // Fractal PingPong 
 
     template <typename FNfloat>
-    float GenFractalPingPong(FNfloat x, FNfloat y)
+    float GenFractalPingPong(FNfloat x, FNfloat y) const
     {
         int seed = mSeed;
         float sum = 0;
@@ -955,7 +1049,7 @@ private:
     }
 
     template <typename FNfloat>
-    float GenFractalPingPong(FNfloat x, FNfloat y, FNfloat z)
+    float GenFractalPingPong(FNfloat x, FNfloat y, FNfloat z) const
     {
         int seed = mSeed;
         float sum = 0;
@@ -980,7 +1074,7 @@ private:
     // Simplex/OpenSimplex2 Noise
 
     template <typename FNfloat>
-    float SingleSimplex(int seed, FNfloat x, FNfloat y)
+    float SingleSimplex(int seed, FNfloat x, FNfloat y) const
     {
         // 2D OpenSimplex2 case uses the same algorithm as ordinary Simplex.
 
@@ -1051,7 +1145,7 @@ private:
     }
 
     template <typename FNfloat>
-    float SingleOpenSimplex2(int seed, FNfloat x, FNfloat y, FNfloat z)
+    float SingleOpenSimplex2(int seed, FNfloat x, FNfloat y, FNfloat z) const
     {
         // 3D OpenSimplex2 case uses two offset rotated cube grids.
 
@@ -1153,7 +1247,7 @@ private:
     // OpenSimplex2S Noise
 
     template <typename FNfloat>
-    float SingleOpenSimplex2S(int seed, FNfloat x, FNfloat y)
+    float SingleOpenSimplex2S(int seed, FNfloat x, FNfloat y) const
     {
         // 2D OpenSimplex2S case is a modified 2D simplex noise.
 
@@ -1284,7 +1378,7 @@ private:
     }
 
     template <typename FNfloat>
-    float SingleOpenSimplex2S(int seed, FNfloat x, FNfloat y, FNfloat z)
+    float SingleOpenSimplex2S(int seed, FNfloat x, FNfloat y, FNfloat z) const
     {
         // 3D OpenSimplex2S case uses two offset rotated cube grids.
 
@@ -1480,7 +1574,7 @@ private:
     // Cellular Noise
 
     template <typename FNfloat>
-    float SingleCellular(int seed, FNfloat x, FNfloat y)
+    float SingleCellular(int seed, FNfloat x, FNfloat y) const
     {
         int xr = FastRound(x);
         int yr = FastRound(y);
@@ -1610,7 +1704,7 @@ private:
     }
 
     template <typename FNfloat>
-    float SingleCellular(int seed, FNfloat x, FNfloat y, FNfloat z)
+    float SingleCellular(int seed, FNfloat x, FNfloat y, FNfloat z) const
     {
         int xr = FastRound(x);
         int yr = FastRound(y);
@@ -1767,7 +1861,7 @@ private:
     // Perlin Noise
 
     template <typename FNfloat>
-    float SinglePerlin(int seed, FNfloat x, FNfloat y)
+    float SinglePerlin(int seed, FNfloat x, FNfloat y) const
     {
         int x0 = FastFloor(x);
         int y0 = FastFloor(y);
@@ -1792,7 +1886,7 @@ private:
     }
 
     template <typename FNfloat>
-    float SinglePerlin(int seed, FNfloat x, FNfloat y, FNfloat z)
+    float SinglePerlin(int seed, FNfloat x, FNfloat y, FNfloat z) const
     {
         int x0 = FastFloor(x);
         int y0 = FastFloor(y);
@@ -1831,7 +1925,7 @@ private:
     // Value Cubic Noise
 
     template <typename FNfloat>
-    float SingleValueCubic(int seed, FNfloat x, FNfloat y)
+    float SingleValueCubic(int seed, FNfloat x, FNfloat y) const
     {
         int x1 = FastFloor(x);
         int y1 = FastFloor(y);
@@ -1861,7 +1955,7 @@ private:
     }
 
     template <typename FNfloat>
-    float SingleValueCubic(int seed, FNfloat x, FNfloat y, FNfloat z)
+    float SingleValueCubic(int seed, FNfloat x, FNfloat y, FNfloat z) const
     {
         int x1 = FastFloor(x);
         int y1 = FastFloor(y);
@@ -1918,7 +2012,7 @@ private:
     // Value Noise
 
     template <typename FNfloat>
-    float SingleValue(int seed, FNfloat x, FNfloat y)
+    float SingleValue(int seed, FNfloat x, FNfloat y) const
     {
         int x0 = FastFloor(x);
         int y0 = FastFloor(y);
@@ -1938,7 +2032,7 @@ private:
     }
 
     template <typename FNfloat>
-    float SingleValue(int seed, FNfloat x, FNfloat y, FNfloat z)
+    float SingleValue(int seed, FNfloat x, FNfloat y, FNfloat z) const
     {
         int x0 = FastFloor(x);
         int y0 = FastFloor(y);
@@ -1970,7 +2064,7 @@ private:
     // Domain Warp
 
     template <typename FNfloat>
-    void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr)
+    void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr) const
     {
         switch (mDomainWarpType)
         {
@@ -1987,7 +2081,7 @@ private:
     }
 
     template <typename FNfloat>
-    void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr)
+    void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr) const
     {
         switch (mDomainWarpType)
         {
@@ -2007,7 +2101,7 @@ private:
     // Domain Warp Single Wrapper
 
     template <typename FNfloat>
-    void DomainWarpSingle(FNfloat& x, FNfloat& y)
+    void DomainWarpSingle(FNfloat& x, FNfloat& y) const
     {
         int seed = mSeed;
         float amp = mDomainWarpAmp * mFractalBounding;
@@ -2021,7 +2115,7 @@ private:
     }
 
     template <typename FNfloat>
-    void DomainWarpSingle(FNfloat& x, FNfloat& y, FNfloat& z)
+    void DomainWarpSingle(FNfloat& x, FNfloat& y, FNfloat& z) const
     {
         int seed = mSeed;
         float amp = mDomainWarpAmp * mFractalBounding;
@@ -2039,7 +2133,7 @@ private:
     // Domain Warp Fractal Progressive
 
     template <typename FNfloat>
-    void DomainWarpFractalProgressive(FNfloat& x, FNfloat& y)
+    void DomainWarpFractalProgressive(FNfloat& x, FNfloat& y) const
     {
         int seed = mSeed;
         float amp = mDomainWarpAmp * mFractalBounding;
@@ -2060,7 +2154,7 @@ private:
     }
 
     template <typename FNfloat>
-    void DomainWarpFractalProgressive(FNfloat& x, FNfloat& y, FNfloat& z)
+    void DomainWarpFractalProgressive(FNfloat& x, FNfloat& y, FNfloat& z) const
     {
         int seed = mSeed;
         float amp = mDomainWarpAmp * mFractalBounding;
@@ -2085,7 +2179,7 @@ private:
     // Domain Warp Fractal Independant
 
     template <typename FNfloat>
-    void DomainWarpFractalIndependent(FNfloat& x, FNfloat& y)
+    void DomainWarpFractalIndependent(FNfloat& x, FNfloat& y) const
     {
         FNfloat xs = x;
         FNfloat ys = y;
@@ -2106,7 +2200,7 @@ private:
     }
 
     template <typename FNfloat>
-    void DomainWarpFractalIndependent(FNfloat& x, FNfloat& y, FNfloat& z)
+    void DomainWarpFractalIndependent(FNfloat& x, FNfloat& y, FNfloat& z) const
     {
         FNfloat xs = x;
         FNfloat ys = y;
@@ -2131,7 +2225,7 @@ private:
     // Domain Warp Basic Grid
 
     template <typename FNfloat>
-    void SingleDomainWarpBasicGrid(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr)
+    void SingleDomainWarpBasicGrid(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr) const
     {
         FNfloat xf = x * frequency;
         FNfloat yf = y * frequency;
@@ -2164,7 +2258,7 @@ private:
     }
 
     template <typename FNfloat>
-    void SingleDomainWarpBasicGrid(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr)
+    void SingleDomainWarpBasicGrid(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr) const
     {
         FNfloat xf = x * frequency;
         FNfloat yf = y * frequency;
@@ -2226,7 +2320,7 @@ private:
     // Domain Warp Simplex/OpenSimplex2
 
     template <typename FNfloat>
-    void SingleDomainWarpSimplexGradient(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr, bool outGradOnly)
+    void SingleDomainWarpSimplexGradient(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr, bool outGradOnly) const
     {
         const float SQRT3 = 1.7320508075688772935274463415059f;
         const float G2 = (3 - SQRT3) / 6;
@@ -2324,7 +2418,7 @@ private:
     }
 
     template <typename FNfloat>
-    void SingleDomainWarpOpenSimplex2Gradient(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr, bool outGradOnly)
+    void SingleDomainWarpOpenSimplex2Gradient(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr, bool outGradOnly) const
     {
         x *= frequency;
         y *= frequency;
@@ -2442,6 +2536,336 @@ private:
         yr += vy * warpAmp;
         zr += vz * warpAmp;
     }
+
+
+#if defined(FNL_SIMD_SSE2) || defined(FNL_SIMD_NEON)
+
+    // Batched grid kernels, each one matches its scalar counterpart lane by lane
+
+    struct Simd
+    {
+#if defined(FNL_SIMD_SSE2)
+        typedef __m128 f32;
+        typedef __m128i i32;
+        typedef __m128 mask;
+
+        static f32 Set(float a) { return _mm_set1_ps(a); }
+        static i32 Set(int a) { return _mm_set1_epi32(a); }
+        static i32 LaneIndex() { return _mm_setr_epi32(0, 1, 2, 3); }
+        static f32 Load(const float* p) { return _mm_loadu_ps(p); }
+        static void Store(float* p, f32 a) { _mm_storeu_ps(p, a); }
+        static void Store(int* p, i32 a) { _mm_storeu_si128((__m128i*)p, a); }
+
+        static f32 Add(f32 a, f32 b) { return _mm_add_ps(a, b); }
+        static f32 Sub(f32 a, f32 b) { return _mm_sub_ps(a, b); }
+        static f32 Mul(f32 a, f32 b) { return _mm_mul_ps(a, b); }
+        static f32 Min(f32 a, f32 b) { return _mm_min_ps(a, b); }
+
+        static i32 Add(i32 a, i32 b) { return _mm_add_epi32(a, b); }
+        static i32 Xor(i32 a, i32 b) { return _mm_xor_si128(a, b); }
+        static i32 And(i32 a, i32 b) { return _mm_and_si128(a, b); }
+        static i32 ShiftRight15(i32 a) { return _mm_srai_epi32(a, 15); }
+
+        static i32 MulLo(i32 a, i32 b)
+        {
+#if defined(FNL_SIMD_SSE41)
+            return _mm_mullo_epi32(a, b);
+#else
+            __m128i even = _mm_mul_epu32(a, b);
+            __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+        }
+
+        static i32 ToIntTruncate(f32 a) { return _mm_cvttps_epi32(a); }
+        static f32 ToFloat(i32 a) { return _mm_cvtepi32_ps(a); }
+
+        static mask Greater(f32 a, f32 b) { return _mm_cmpgt_ps(a, b); }
+        static mask Less(f32 a, f32 b) { return _mm_cmplt_ps(a, b); }
+        static i32 MaskToInt(mask m) { return _mm_castps_si128(m); }
+        static f32 Select(mask m, f32 a, f32 b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+        static i32 Select(mask m, i32 a, i32 b) { return _mm_castps_si128(Select(m, _mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+        static f32 KeepIf(mask m, f32 a) { return _mm_and_ps(m, a); }
+#else
+        typedef float32x4_t f32;
+        typedef int32x4_t i32;
+        typedef uint32x4_t mask;
+
+        static f32 Set(float a) { return vdupq_n_f32(a); }
+        static i32 Set(int a) { return vdupq_n_s32(a); }
+        static i32 LaneIndex() { static const int lanes[4] = { 0, 1, 2, 3 }; return vld1q_s32(lanes); }
+        static f32 Load(const float* p) { return vld1q_f32(p); }
+        static void Store(float* p, f32 a) { vst1q_f32(p, a); }
+        static void Store(int* p, i32 a) { vst1q_s32(p, a); }
+
+        static f32 Add(f32 a, f32 b) { return vaddq_f32(a, b); }
+        static f32 Sub(f32 a, f32 b) { return vsubq_f32(a, b); }
+        static f32 Mul(f32 a, f32 b) { return vmulq_f32(a, b); }
+        static f32 Min(f32 a, f32 b) { return vminq_f32(a, b); }
+
+        static i32 Add(i32 a, i32 b) { return vaddq_s32(a, b); }
+        static i32 Xor(i32 a, i32 b) { return veorq_s32(a, b); }
+        static i32 And(i32 a, i32 b) { return vandq_s32(a, b); }
+        static i32 ShiftRight15(i32 a) { return vshrq_n_s32(a, 15); }
+        static i32 MulLo(i32 a, i32 b) { return vmulq_s32(a, b); }
+
+        static i32 ToIntTruncate(f32 a) { return vcvtq_s32_f32(a); }
+        static f32 ToFloat(i32 a) { return vcvtq_f32_s32(a); }
+
+        static mask Greater(f32 a, f32 b) { return vcgtq_f32(a, b); }
+        static mask Less(f32 a, f32 b) { return vcltq_f32(a, b); }
+        static i32 MaskToInt(mask m) { return vreinterpretq_s32_u32(m); }
+        static f32 Select(mask m, f32 a, f32 b) { return vbslq_f32(m, a, b); }
+        static i32 Select(mask m, i32 a, i32 b) { return vbslq_s32(m, a, b); }
+        static f32 KeepIf(mask m, f32 a) { return vreinterpretq_f32_u32(vandq_u32(m, vreinterpretq_u32_f32(a))); }
+#endif
+    };
+
+    bool CanBatchNoise2D() const
+    {
+        return (mNoiseType == NoiseType_Perlin || mNoiseType == NoiseType_OpenSimplex2) &&
+            mFractalType != FractalType_Ridged && mFractalType != FractalType_PingPong;
+    }
+
+    bool CanBatchNoise3D() const
+    {
+        return mNoiseType == NoiseType_Perlin && mTransformType3D == TransformType3D_None &&
+            mFractalType != FractalType_Ridged && mFractalType != FractalType_PingPong;
+    }
+
+    static Simd::i32 FastFloor4(Simd::f32 f)
+    {
+        // A negative lane's mask is -1, the same "(int)f - 1" as FastFloor
+        return Simd::Add(Simd::ToIntTruncate(f), Simd::MaskToInt(Simd::Less(f, Simd::Set(0.0f))));
+    }
+
+    static Simd::f32 Lerp4(Simd::f32 a, Simd::f32 b, Simd::f32 t) { return Simd::Add(a, Simd::Mul(t, Simd::Sub(b, a))); }
+
+    static Simd::f32 InterpQuintic4(Simd::f32 t)
+    {
+        Simd::f32 inner = Simd::Add(Simd::Mul(t, Simd::Sub(Simd::Mul(t, Simd::Set(6.0f)), Simd::Set(15.0f))), Simd::Set(10.0f));
+        return Simd::Mul(Simd::Mul(Simd::Mul(t, t), t), inner);
+    }
+
+    static Simd::i32 Hash4(int seed, Simd::i32 xPrimed, Simd::i32 yPrimed)
+    {
+        Simd::i32 hash = Simd::Xor(Simd::Xor(Simd::Set(seed), xPrimed), yPrimed);
+        return Simd::MulLo(hash, Simd::Set(0x27d4eb2d));
+    }
+
+    static Simd::i32 Hash4(int seed, Simd::i32 xPrimed, Simd::i32 yPrimed, Simd::i32 zPrimed)
+    {
+        Simd::i32 hash = Simd::Xor(Simd::Xor(Simd::Xor(Simd::Set(seed), xPrimed), yPrimed), zPrimed);
+        return Simd::MulLo(hash, Simd::Set(0x27d4eb2d));
+    }
+
+    static Simd::f32 GradCoord4(int seed, Simd::i32 xPrimed, Simd::i32 yPrimed, Simd::f32 xd, Simd::f32 yd)
+    {
+        Simd::i32 hash = Hash4(seed, xPrimed, yPrimed);
+        hash = Simd::And(Simd::Xor(hash, Simd::ShiftRight15(hash)), Simd::Set(127 << 1));
+
+        // No gather below AVX2, the table is small enough to stay in L1
+        int index[4];
+        Simd::Store(index, hash);
+        const float* table = Lookup<float>::Gradients2D;
+        float xg[4] = { table[index[0]], table[index[1]], table[index[2]], table[index[3]] };
+        float yg[4] = { table[index[0] | 1], table[index[1] | 1], table[index[2] | 1], table[index[3] | 1] };
+
+        return Simd::Add(Simd::Mul(xd, Simd::Load(xg)), Simd::Mul(yd, Simd::Load(yg)));
+    }
+
+    static Simd::f32 GradCoord4(int seed, Simd::i32 xPrimed, Simd::i32 yPrimed, Simd::i32 zPrimed, Simd::f32 xd, Simd::f32 yd, Simd::f32 zd)
+    {
+        Simd::i32 hash = Hash4(seed, xPrimed, yPrimed, zPrimed);
+        hash = Simd::And(Simd::Xor(hash, Simd::ShiftRight15(hash)), Simd::Set(63 << 2));
+
+        int index[4];
+        Simd::Store(index, hash);
+        const float* table = Lookup<float>::Gradients3D;
+        float xg[4] = { table[index[0]], table[index[1]], table[index[2]], table[index[3]] };
+        float yg[4] = { table[index[0] | 1], table[index[1] | 1], table[index[2] | 1], table[index[3] | 1] };
+        float zg[4] = { table[index[0] | 2], table[index[1] | 2], table[index[2] | 2], table[index[3] | 2] };
+
+        return Simd::Add(Simd::Add(Simd::Mul(xd, Simd::Load(xg)), Simd::Mul(yd, Simd::Load(yg))), Simd::Mul(zd, Simd::Load(zg)));
+    }
+
+    void TransformNoiseCoordinate4(Simd::f32& x, Simd::f32& y) const
+    {
+        x = Simd::Mul(x, Simd::Set(mFrequency));
+        y = Simd::Mul(y, Simd::Set(mFrequency));
+
+        if (mNoiseType == NoiseType_OpenSimplex2)
+        {
+            const float SQRT3 = (float)1.7320508075688772935274463415059;
+            const float F2 = 0.5f * (SQRT3 - 1);
+            Simd::f32 t = Simd::Mul(Simd::Add(x, y), Simd::Set(F2));
+            x = Simd::Add(x, t);
+            y = Simd::Add(y, t);
+        }
+    }
+
+    Simd::f32 GenNoiseSingle4(int seed, Simd::f32 x, Simd::f32 y) const
+    {
+        return mNoiseType == NoiseType_Perlin ? SinglePerlin4(seed, x, y) : SingleSimplex4(seed, x, y);
+    }
+
+    // GenFractalFBm, or a single octave like GetNoise does for the non fractal types
+    Simd::f32 GenNoise4(Simd::f32 x, Simd::f32 y) const
+    {
+        if (mFractalType != FractalType_FBm)
+        {
+            return GenNoiseSingle4(mSeed, x, y);
+        }
+
+        int seed = mSeed;
+        Simd::f32 sum = Simd::Set(0.0f);
+        Simd::f32 amp = Simd::Set(mFractalBounding);
+
+        for (int i = 0; i < mOctaves; i++)
+        {
+            Simd::f32 noise = GenNoiseSingle4(seed++, x, y);
+            sum = Simd::Add(sum, Simd::Mul(noise, amp));
+            amp = Simd::Mul(amp, Lerp4(Simd::Set(1.0f), Simd::Mul(Simd::Min(Simd::Add(noise, Simd::Set(1.0f)), Simd::Set(2.0f)), Simd::Set(0.5f)), Simd::Set(mWeightedStrength)));
+
+            x = Simd::Mul(x, Simd::Set(mLacunarity));
+            y = Simd::Mul(y, Simd::Set(mLacunarity));
+            amp = Simd::Mul(amp, Simd::Set(mGain));
+        }
+
+        return sum;
+    }
+
+    Simd::f32 GenNoise4(Simd::f32 x, Simd::f32 y, Simd::f32 z) const
+    {
+        if (mFractalType != FractalType_FBm)
+        {
+            return SinglePerlin4(mSeed, x, y, z);
+        }
+
+        int seed = mSeed;
+        Simd::f32 sum = Simd::Set(0.0f);
+        Simd::f32 amp = Simd::Set(mFractalBounding);
+
+        for (int i = 0; i < mOctaves; i++)
+        {
+            Simd::f32 noise = SinglePerlin4(seed++, x, y, z);
+            sum = Simd::Add(sum, Simd::Mul(noise, amp));
+            amp = Simd::Mul(amp, Lerp4(Simd::Set(1.0f), Simd::Mul(Simd::Min(Simd::Add(noise, Simd::Set(1.0f)), Simd::Set(2.0f)), Simd::Set(0.5f)), Simd::Set(mWeightedStrength)));
+
+            x = Simd::Mul(x, Simd::Set(mLacunarity));
+            y = Simd::Mul(y, Simd::Set(mLacunarity));
+            z = Simd::Mul(z, Simd::Set(mLacunarity));
+            amp = Simd::Mul(amp, Simd::Set(mGain));
+        }
+
+        return sum;
+    }
+
+    static Simd::f32 SinglePerlin4(int seed, Simd::f32 x, Simd::f32 y)
+    {
+        Simd::i32 x0 = FastFloor4(x);
+        Simd::i32 y0 = FastFloor4(y);
+
+        Simd::f32 xd0 = Simd::Sub(x, Simd::ToFloat(x0));
+        Simd::f32 yd0 = Simd::Sub(y, Simd::ToFloat(y0));
+        Simd::f32 xd1 = Simd::Sub(xd0, Simd::Set(1.0f));
+        Simd::f32 yd1 = Simd::Sub(yd0, Simd::Set(1.0f));
+
+        Simd::f32 xs = InterpQuintic4(xd0);
+        Simd::f32 ys = InterpQuintic4(yd0);
+
+        x0 = Simd::MulLo(x0, Simd::Set(PrimeX));
+        y0 = Simd::MulLo(y0, Simd::Set(PrimeY));
+        Simd::i32 x1 = Simd::Add(x0, Simd::Set(PrimeX));
+        Simd::i32 y1 = Simd::Add(y0, Simd::Set(PrimeY));
+
+        Simd::f32 xf0 = Lerp4(GradCoord4(seed, x0, y0, xd0, yd0), GradCoord4(seed, x1, y0, xd1, yd0), xs);
+        Simd::f32 xf1 = Lerp4(GradCoord4(seed, x0, y1, xd0, yd1), GradCoord4(seed, x1, y1, xd1, yd1), xs);
+
+        return Simd::Mul(Lerp4(xf0, xf1, ys), Simd::Set(1.4247691104677813f));
+    }
+
+    static Simd::f32 SinglePerlin4(int seed, Simd::f32 x, Simd::f32 y, Simd::f32 z)
+    {
+        Simd::i32 x0 = FastFloor4(x);
+        Simd::i32 y0 = FastFloor4(y);
+        Simd::i32 z0 = FastFloor4(z);
+
+        Simd::f32 xd0 = Simd::Sub(x, Simd::ToFloat(x0));
+        Simd::f32 yd0 = Simd::Sub(y, Simd::ToFloat(y0));
+        Simd::f32 zd0 = Simd::Sub(z, Simd::ToFloat(z0));
+        Simd::f32 xd1 = Simd::Sub(xd0, Simd::Set(1.0f));
+        Simd::f32 yd1 = Simd::Sub(yd0, Simd::Set(1.0f));
+        Simd::f32 zd1 = Simd::Sub(zd0, Simd::Set(1.0f));
+
+        Simd::f32 xs = InterpQuintic4(xd0);
+        Simd::f32 ys = InterpQuintic4(yd0);
+        Simd::f32 zs = InterpQuintic4(zd0);
+
+        x0 = Simd::MulLo(x0, Simd::Set(PrimeX));
+        y0 = Simd::MulLo(y0, Simd::Set(PrimeY));
+        z0 = Simd::MulLo(z0, Simd::Set(PrimeZ));
+        Simd::i32 x1 = Simd::Add(x0, Simd::Set(PrimeX));
+        Simd::i32 y1 = Simd::Add(y0, Simd::Set(PrimeY));
+        Simd::i32 z1 = Simd::Add(z0, Simd::Set(PrimeZ));
+
+        Simd::f32 xf00 = Lerp4(GradCoord4(seed, x0, y0, z0, xd0, yd0, zd0), GradCoord4(seed, x1, y0, z0, xd1, yd0, zd0), xs);
+        Simd::f32 xf10 = Lerp4(GradCoord4(seed, x0, y1, z0, xd0, yd1, zd0), GradCoord4(seed, x1, y1, z0, xd1, yd1, zd0), xs);
+        Simd::f32 xf01 = Lerp4(GradCoord4(seed, x0, y0, z1, xd0, yd0, zd1), GradCoord4(seed, x1, y0, z1, xd1, yd0, zd1), xs);
+        Simd::f32 xf11 = Lerp4(GradCoord4(seed, x0, y1, z1, xd0, yd1, zd1), GradCoord4(seed, x1, y1, z1, xd1, yd1, zd1), xs);
+
+        Simd::f32 yf0 = Lerp4(xf00, xf10, ys);
+        Simd::f32 yf1 = Lerp4(xf01, xf11, ys);
+
+        return Simd::Mul(Lerp4(yf0, yf1, zs), Simd::Set(0.964921414852142333984375f));
+    }
+
+    static Simd::f32 SingleSimplex4(int seed, Simd::f32 x, Simd::f32 y)
+    {
+        // Same constants, computed the same way, as SingleSimplex
+        const float SQRT3 = 1.7320508075688772935274463415059f;
+        const float G2 = (3 - SQRT3) / 6;
+        const float cT = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2));
+        const float cA = (float)(-2 * (1 - 2 * G2) * (1 - 2 * G2));
+
+        Simd::i32 i = FastFloor4(x);
+        Simd::i32 j = FastFloor4(y);
+        Simd::f32 xi = Simd::Sub(x, Simd::ToFloat(i));
+        Simd::f32 yi = Simd::Sub(y, Simd::ToFloat(j));
+
+        Simd::f32 t = Simd::Mul(Simd::Add(xi, yi), Simd::Set(G2));
+        Simd::f32 x0 = Simd::Sub(xi, t);
+        Simd::f32 y0 = Simd::Sub(yi, t);
+
+        i = Simd::MulLo(i, Simd::Set(PrimeX));
+        j = Simd::MulLo(j, Simd::Set(PrimeY));
+
+        Simd::f32 zero = Simd::Set(0.0f);
+
+        Simd::f32 a = Simd::Sub(Simd::Sub(Simd::Set(0.5f), Simd::Mul(x0, x0)), Simd::Mul(y0, y0));
+        Simd::f32 aa = Simd::Mul(a, a);
+        Simd::f32 n0 = Simd::KeepIf(Simd::Greater(a, zero), Simd::Mul(Simd::Mul(aa, aa), GradCoord4(seed, i, j, x0, y0)));
+
+        Simd::f32 c = Simd::Add(Simd::Mul(Simd::Set(cT), t), Simd::Add(Simd::Set(cA), a));
+        Simd::f32 x2 = Simd::Add(x0, Simd::Set(2 * (float)G2 - 1));
+        Simd::f32 y2 = Simd::Add(y0, Simd::Set(2 * (float)G2 - 1));
+        Simd::f32 cc = Simd::Mul(c, c);
+        Simd::f32 n2 = Simd::KeepIf(Simd::Greater(c, zero), Simd::Mul(Simd::Mul(cc, cc), GradCoord4(seed, Simd::Add(i, Simd::Set(PrimeX)), Simd::Add(j, Simd::Set(PrimeY)), x2, y2)));
+
+        // The middle corner is one step along y when y0 > x0, otherwise along x
+        Simd::mask yStep = Simd::Greater(y0, x0);
+        Simd::f32 x1 = Simd::Select(yStep, Simd::Add(x0, Simd::Set((float)G2)), Simd::Add(x0, Simd::Set((float)G2 - 1)));
+        Simd::f32 y1 = Simd::Select(yStep, Simd::Add(y0, Simd::Set((float)G2 - 1)), Simd::Add(y0, Simd::Set((float)G2)));
+        Simd::i32 i1 = Simd::Select(yStep, i, Simd::Add(i, Simd::Set(PrimeX)));
+        Simd::i32 j1 = Simd::Select(yStep, Simd::Add(j, Simd::Set(PrimeY)), j);
+        Simd::f32 b = Simd::Sub(Simd::Sub(Simd::Set(0.5f), Simd::Mul(x1, x1)), Simd::Mul(y1, y1));
+        Simd::f32 bb = Simd::Mul(b, b);
+        Simd::f32 n1 = Simd::KeepIf(Simd::Greater(b, zero), Simd::Mul(Simd::Mul(bb, bb), GradCoord4(seed, i1, j1, x1, y1)));
+
+        return Simd::Mul(Simd::Add(Simd::Add(n0, n1), n2), Simd::Set(99.83685446303647f));
+    }
+
+#endif
 };
 
 template <>
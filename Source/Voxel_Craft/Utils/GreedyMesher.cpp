@@ -0,0 +1,682 @@
+#include "GreedyMesher.h"
+
+namespace
+{
+	// One occupancy plane per EBlock value
+	constexpr int32 BlockTypeCount = static_cast<int32>(EBlock::Water) + 1;
+	static_assert(BlockTypeCount * 2 <= 64, "Face planes are tracked in a 64-bit set");
+
+	bool IsSolidType(const int32 Type)
+	{
+		return Type != static_cast<int32>(EBlock::Air) && Type != static_cast<int32>(EBlock::Water);
+	}
+
+	// Bits of word W that fall inside [Start, End)
+	uint64 WordRangeMask(const int W, const int Start, const int End)
+	{
+		const int Lo = FMath::Max(Start - W * 64, 0);
+		const int Hi = FMath::Min(End - W * 64, 64);
+		if (Hi <= Lo) return 0;
+
+		const uint64 HiMask = Hi == 64 ? ~uint64(0) : (uint64(1) << Hi) - 1;
+		return HiMask & (~uint64(0) << Lo);
+	}
+
+	// First set bit of a multi-word row at or after Start, Limit if there is none
+	int FindFirstSet(const uint64* Row, const int Start, const int Limit)
+	{
+		if (Start >= Limit) return Limit;
+
+		const int LastWord = (Limit - 1) >> 6;
+		int W = Start >> 6;
+		uint64 Word = Row[W] & (~uint64(0) << (Start & 63));
+
+		while (!Word)
+		{
+			if (++W > LastWord) return Limit;
+			Word = Row[W];
+		}
+		return FMath::Min(W * 64 + static_cast<int>(FMath::CountTrailingZeros64(Word)), Limit);
+	}
+
+	// First clear bit of a multi-word row at or after Start, Limit if the rest is set
+	int FindFirstClear(const uint64* Row, const int Start, const int Limit)
+	{
+		if (Start >= Limit) return Limit;
+
+		const int LastWord = (Limit - 1) >> 6;
+		int W = Start >> 6;
+		uint64 Word = ~Row[W] & (~uint64(0) << (Start & 63));
+
+		while (!Word)
+		{
+			if (++W > LastWord) return Limit;
+			Word = ~Row[W];
+		}
+		return FMath::Min(W * 64 + static_cast<int>(FMath::CountTrailingZeros64(Word)), Limit);
+	}
+
+	void ClearRange(uint64* Row, const int Start, const int Count)
+	{
+		const int End = Start + Count;
+		for (int W = Start >> 6; W <= (End - 1) >> 6; ++W)
+		{
+			Row[W] &= ~WordRangeMask(W, Start, End);
+		}
+	}
+}
+
+FGreedyMesher::FGreedyMesher(const FChunkMeshSnapshot& InSnapshot)
+	: Snapshot(InSnapshot)
+{
+}
+
+TArray<FChunkMeshData> FGreedyMesher::GenerateMesh(const EMeshingAlgorithm Algorithm)
+{
+	TArray<FChunkMeshData> Result;
+	Result.Reserve(Snapshot.GetSectionCount() * MaterialCount);
+
+	for (int32 Section = 0; Section < Snapshot.GetSectionCount(); ++Section)
+	{
+		Result.Append(GenerateSectionMesh(Algorithm, Section));
+	}
+
+	return Result;
+}
+
+TArray<FChunkMeshData> FGreedyMesher::GenerateSectionMesh(const EMeshingAlgorithm Algorithm, const int32 Section)
+{
+	MeshPerMaterial.Reset();
+	MeshPerMaterial.SetNum(MaterialCount);
+	VertexCountPerMat.Init(0, MaterialCount);
+
+	const FIntVector& ChunkSize = Snapshot.Size;
+	FIntVector Begin(0, 0, Section * FChunkVoxelData::SectionHeight);
+	FIntVector End(ChunkSize.X, ChunkSize.Y, FMath::Min(Begin.Z + FChunkVoxelData::SectionHeight, ChunkSize.Z));
+
+	// Air layers outside the occupied range own no faces. End keeps one layer past the top so the top faces' plane is swept
+	Begin.Z = FMath::Max(Begin.Z, Snapshot.OccupiedMinZ);
+	End.Z = FMath::Min(End.Z, Snapshot.OccupiedMaxZ + 2);
+	if (Begin.Z >= End.Z)
+	{
+		return MoveTemp(MeshPerMaterial);
+	}
+
+	if (Algorithm == EMeshingAlgorithm::Binary)
+	{
+		GenerateMeshBinary(Begin, End);
+	}
+	else
+	{
+		GenerateMeshScalar(Begin, End);
+	}
+
+	return MoveTemp(MeshPerMaterial);
+}
+
+void FGreedyMesher::GenerateMeshScalar(const FIntVector& Begin, const FIntVector& End)
+{
+	const FIntVector& ChunkSize = Snapshot.Size;
+	const EBlock* Blocks = Snapshot.Blocks.GetData();
+
+	// Sweep over each axis (X, Y, Z)
+	for (int Axis = 0; Axis < 3; ++Axis)
+	{
+		// 2 Perpendicular axis
+		const int Axis1 = (Axis + 1) % 3;
+		const int Axis2 = (Axis + 2) % 3;
+
+		// Slices over the face planes the box owns: Begin to End - 1, plus the far side of the chunk
+		const int SliceBegin = Begin[Axis] - 1;
+		const int SliceEnd = End[Axis] == ChunkSize[Axis] ? End[Axis] : End[Axis] - 1;
+
+		const int Axis1Begin = Begin[Axis1];
+		const int Axis2Begin = Begin[Axis2];
+		const int Axis1Limit = End[Axis1] - Axis1Begin;
+		const int Axis2Limit = End[Axis2] - Axis2Begin;
+
+		// Padded volume strides, stepping one voxel along each axis
+		const int32 AxisStride = Snapshot.GetStride(Axis);
+		const int32 Axis1Stride = Snapshot.GetStride(Axis1);
+		const int32 Axis2Stride = Snapshot.GetStride(Axis2);
+
+		auto DeltaAxis1 = FIntVector::ZeroValue;
+		auto DeltaAxis2 = FIntVector::ZeroValue;
+
+		auto ChunkItr = FIntVector::ZeroValue;
+		auto AxisMask = FIntVector::ZeroValue;
+
+		AxisMask[Axis] = 1;
+
+		TArray<FMask> Mask;
+		Mask.SetNum(Axis1Limit * Axis2Limit);
+
+		// Check each slice of the chunk
+		for (ChunkItr[Axis] = SliceBegin; ChunkItr[Axis] < SliceEnd;)
+		{
+			// Nothing to mesh between two layers of the same quiet block
+			if (Axis == 2 && Snapshot.IsQuietPair(ChunkItr[Axis]))
+			{
+				++ChunkItr[Axis];
+				continue;
+			}
+
+			int N = 0;
+
+			// Padded index of the box corner on this slice
+			FIntVector SliceOrigin = Begin;
+			SliceOrigin[Axis] = ChunkItr[Axis];
+			const int32 SliceIndex = Snapshot.GetPaddedIndex(SliceOrigin);
+
+			// Compute Mask
+			for (int j = 0; j < Axis2Limit; ++j)
+			{
+				int32 Index = SliceIndex + j * Axis2Stride;
+
+				// Z runs along Axis2 for the X sweep and along Axis1 for the Y sweep
+				const bool bQuietRow = Axis == 0 && Snapshot.IsQuietLayer(Axis2Begin + j);
+
+				for (int i = 0; i < Axis1Limit; ++i, Index += Axis1Stride)
+				{
+					if (bQuietRow || (Axis == 1 && Snapshot.IsQuietLayer(Axis1Begin + i)))
+					{
+						Mask[N++] = FMask{EBlock::Null, 0};
+						continue;
+					}
+
+					const EBlock CurrentBlock = Blocks[Index];
+
+					const EBlock CompareBlock = Blocks[Index + AxisStride];
+					
+					const bool CurrentBlockIsSolid = (CurrentBlock != EBlock::Air && CurrentBlock != EBlock::Water);
+					const bool CompareBlockIsSolid = (CompareBlock != EBlock::Air && CompareBlock != EBlock::Water);
+					const bool CurrentBlockIsWater = (CurrentBlock == EBlock::Water);
+					const bool CompareBlockIsWater = (CompareBlock == EBlock::Water);
+
+					if ((CurrentBlock == EBlock::Log && CompareBlock == EBlock::Leaves))
+					{
+						Mask[N++] = FMask{CurrentBlock, 1}; // Show log face
+					}
+					else if ((CompareBlock == EBlock::Log && CurrentBlock == EBlock::Leaves))
+					{
+						Mask[N++] = FMask{CompareBlock, -1};
+					}
+					else if (CurrentBlockIsSolid && (!CompareBlockIsSolid)) // land vs. air or land vs. water
+					{
+						Mask[N++] = FMask{CurrentBlock, 1};
+					}
+					else if (CurrentBlockIsWater && CompareBlock == EBlock::Air) // water vs. air
+					{
+						Mask[N++] = FMask{CurrentBlock, 1};
+					}
+					else if (CompareBlockIsSolid && (!CurrentBlockIsSolid)) // land vs. air or land vs. water (opposite direction)
+					{
+						Mask[N++] = FMask{CompareBlock, -1};
+					}
+					else if (CompareBlockIsWater && CurrentBlock == EBlock::Air) // water vs. air (opposite a direction)
+					{
+						Mask[N++] = FMask{CompareBlock, -1};
+					}
+					else
+					{
+						Mask[N++] = FMask{EBlock::Null, 0}; // skip faces between solid/solid, water/water, or air/air
+					}
+				}
+			}
+
+			++ChunkItr[Axis];
+			N = 0;
+
+			// Generate Mesh From Mask
+			for (int j = 0; j < Axis2Limit; ++j)
+			{
+				for (int i = 0; i < Axis1Limit;)
+				{
+					if (Mask[N].Normal != 0)
+					{
+						const auto CurrentMask = Mask[N];
+						ChunkItr[Axis1] = Axis1Begin + i;
+						ChunkItr[Axis2] = Axis2Begin + j;
+
+						int Width;
+
+						for (Width = 1; i + Width < Axis1Limit && CompareMask(Mask[N + Width], CurrentMask); ++Width)
+						{
+						}
+
+						int Height;
+						bool Done = false;
+
+						for (Height = 1; j + Height < Axis2Limit; ++Height)
+						{
+							for (int k = 0; k < Width; ++k)
+							{
+								if (CompareMask(Mask[N + k + Height * Axis1Limit], CurrentMask)) continue;
+
+								Done = true;
+								break;
+							}
+
+							if (Done) break;
+						}
+
+						DeltaAxis1[Axis1] = Width;
+						DeltaAxis2[Axis2] = Height;
+
+						CreateQuad(
+							CurrentMask, AxisMask, Width, Height,
+							ChunkItr,
+							ChunkItr + DeltaAxis1,
+							ChunkItr + DeltaAxis2,
+							ChunkItr + DeltaAxis1 + DeltaAxis2
+						);
+
+						DeltaAxis1 = FIntVector::ZeroValue;
+						DeltaAxis2 = FIntVector::ZeroValue;
+
+						for (int l = 0; l < Height; ++l)
+						{
+							for (int k = 0; k < Width; ++k)
+							{
+								Mask[N + k + l * Axis1Limit] = FMask{EBlock::Null, 0};
+							}
+						}
+
+						i += Width;
+						N += Width;
+					}
+					else
+					{
+						i++;
+						N++;
+					}
+				}
+			}
+		}
+	}
+}
+
+void FGreedyMesher::GenerateMeshBinary(const FIntVector& Begin, const FIntVector& End)
+{
+	const FIntVector& ChunkSize = Snapshot.Size;
+	const EBlock* Blocks = Snapshot.Blocks.GetData();
+
+	constexpr int32 AirType = static_cast<int32>(EBlock::Air);
+	constexpr int32 WaterType = static_cast<int32>(EBlock::Water);
+	constexpr int32 LogType = static_cast<int32>(EBlock::Log);
+	constexpr int32 LeavesType = static_cast<int32>(EBlock::Leaves);
+
+	// Sweep over each axis (X, Y, Z)
+	for (int Axis = 0; Axis < 3; ++Axis)
+	{
+		// 2 Perpendicular axis
+		const int Axis1 = (Axis + 1) % 3;
+		const int Axis2 = (Axis + 2) % 3;
+
+		// Slices over the face planes the box owns: Begin to End - 1, plus the far side of the chunk
+		const int SliceBegin = Begin[Axis] - 1;
+		const int SliceEnd = End[Axis] == ChunkSize[Axis] ? End[Axis] : End[Axis] - 1;
+
+		const int Axis1Begin = Begin[Axis1];
+		const int Axis2Begin = Begin[Axis2];
+		const int Axis1Limit = End[Axis1] - Axis1Begin;
+		const int Axis2Limit = End[Axis2] - Axis2Begin;
+
+		const int32 AxisStride = Snapshot.GetStride(Axis);
+		const int32 Axis1Stride = Snapshot.GetStride(Axis1);
+		const int32 Axis2Stride = Snapshot.GetStride(Axis2);
+		const int32 LayerIndex = Snapshot.GetPaddedIndex(Begin) - Begin[Axis] * AxisStride;
+
+		// A slice is Axis2Limit rows of bits along Axis1, so quads merge in the same order as the scalar mesher
+		const int Words = (Axis1Limit + 63) / 64;
+		const int32 PlaneSize = Axis2Limit * Words;
+
+		auto ChunkItr = FIntVector::ZeroValue;
+		auto AxisMask = FIntVector::ZeroValue;
+
+		AxisMask[Axis] = 1;
+
+		// Per block type occupancy of the layers on either side of the slice
+		TArray<uint64> CurrentLayer;
+		TArray<uint64> CompareLayer;
+		CurrentLayer.SetNumUninitialized(BlockTypeCount * PlaneSize);
+		CompareLayer.SetNumUninitialized(BlockTypeCount * PlaneSize);
+
+		// Visible faces, one plane per block type and normal: +1 at even planes, -1 at odd planes
+		TArray<uint64> Faces;
+		Faces.SetNumUninitialized(BlockTypeCount * 2 * PlaneSize);
+
+		const auto BuildLayer = [&](TArray<uint64>& Layer, const int Slice)
+		{
+			FMemory::Memzero(Layer.GetData(), Layer.Num() * sizeof(uint64));
+
+			// Quiet cells are left empty on both sides of the slice, so they produce no faces
+			for (int j = 0; j < Axis2Limit; ++j)
+			{
+				if (Axis == 0 && Snapshot.IsQuietLayer(Axis2Begin + j)) continue;
+
+				int32 Index = LayerIndex + Slice * AxisStride + j * Axis2Stride;
+				uint64* Row = Layer.GetData() + j * Words;
+
+				for (int i = 0; i < Axis1Limit; ++i, Index += Axis1Stride)
+				{
+					if (Axis == 1 && Snapshot.IsQuietLayer(Axis1Begin + i)) continue;
+
+					Row[static_cast<int32>(Blocks[Index]) * PlaneSize + (i >> 6)] |= uint64(1) << (i & 63);
+				}
+			}
+		};
+
+		bool bCurrentLayerBuilt = false;
+
+		// Check each slice of the chunk
+		for (int Slice = SliceBegin; Slice < SliceEnd; ++Slice)
+		{
+			// Nothing to mesh between two layers of the same quiet block
+			if (Axis == 2 && Snapshot.IsQuietPair(Slice))
+			{
+				bCurrentLayerBuilt = false;
+				continue;
+			}
+
+			if (!bCurrentLayerBuilt)
+			{
+				BuildLayer(CurrentLayer, Slice);
+			}
+			BuildLayer(CompareLayer, Slice + 1);
+
+			const uint64* Current = CurrentLayer.GetData();
+			const uint64* Compare = CompareLayer.GetData();
+
+			// Compute face planes with the same rules as the scalar mask
+			uint64 ActivePlanes = 0;
+			for (int32 Cell = 0; Cell < PlaneSize; ++Cell)
+			{
+				uint64 CurrentSolid = 0;
+				uint64 CompareSolid = 0;
+				for (int32 Type = 0; Type < BlockTypeCount; ++Type)
+				{
+					if (!IsSolidType(Type)) continue;
+					CurrentSolid |= Current[Type * PlaneSize + Cell];
+					CompareSolid |= Compare[Type * PlaneSize + Cell];
+				}
+
+				for (int32 Type = 0; Type < BlockTypeCount; ++Type)
+				{
+					uint64 Positive = 0;
+					uint64 Negative = 0;
+
+					if (Type == WaterType)
+					{
+						// water vs. air
+						Positive = Current[Type * PlaneSize + Cell] & Compare[AirType * PlaneSize + Cell];
+						Negative = Compare[Type * PlaneSize + Cell] & Current[AirType * PlaneSize + Cell];
+					}
+					else if (Type != AirType)
+					{
+						// land vs. air or land vs. water
+						Positive = Current[Type * PlaneSize + Cell] & ~CompareSolid;
+						Negative = Compare[Type * PlaneSize + Cell] & ~CurrentSolid;
+
+						if (Type == LogType) // Show log faces against leaves
+						{
+							Positive |= Current[LogType * PlaneSize + Cell] & Compare[LeavesType * PlaneSize + Cell];
+							Negative |= Compare[LogType * PlaneSize + Cell] & Current[LeavesType * PlaneSize + Cell];
+						}
+					}
+
+					Faces[(Type * 2) * PlaneSize + Cell] = Positive;
+					Faces[(Type * 2 + 1) * PlaneSize + Cell] = Negative;
+
+					if (Positive) ActivePlanes |= uint64(1) << (Type * 2);
+					if (Negative) ActivePlanes |= uint64(1) << (Type * 2 + 1);
+				}
+			}
+
+			ChunkItr[Axis] = Slice + 1;
+
+			// Generate Mesh From face planes, a cell has at most one face so planes never overlap
+			for (int j = 0; ActivePlanes && j < Axis2Limit; ++j)
+			{
+				for (int i = 0; i < Axis1Limit;)
+				{
+					// Earliest face left in this row across all planes
+					int Start = Axis1Limit;
+					int32 Plane = INDEX_NONE;
+					for (uint64 Remaining = ActivePlanes; Remaining; Remaining &= Remaining - 1)
+					{
+						const int32 Candidate = static_cast<int32>(FMath::CountTrailingZeros64(Remaining));
+						const int First = FindFirstSet(&Faces[Candidate * PlaneSize + j * Words], i, Axis1Limit);
+						if (First < Start)
+						{
+							Start = First;
+							Plane = Candidate;
+						}
+					}
+
+					if (Plane == INDEX_NONE) break;
+
+					uint64* PlaneBits = &Faces[Plane * PlaneSize];
+					const int Width = FindFirstClear(PlaneBits + j * Words, Start, Axis1Limit) - Start;
+
+					int Height = 1;
+					while (j + Height < Axis2Limit &&
+						FindFirstClear(PlaneBits + (j + Height) * Words, Start, Start + Width) == Start + Width)
+					{
+						++Height;
+					}
+
+					for (int l = 0; l < Height; ++l)
+					{
+						ClearRange(PlaneBits + (j + l) * Words, Start, Width);
+					}
+
+					ChunkItr[Axis1] = Axis1Begin + Start;
+					ChunkItr[Axis2] = Axis2Begin + j;
+
+					auto DeltaAxis1 = FIntVector::ZeroValue;
+					auto DeltaAxis2 = FIntVector::ZeroValue;
+					DeltaAxis1[Axis1] = Width;
+					DeltaAxis2[Axis2] = Height;
+
+					const FMask CurrentMask{static_cast<EBlock>(Plane / 2), (Plane % 2 == 0) ? 1 : -1};
+
+					CreateQuad(
+						CurrentMask, AxisMask, Width, Height,
+						ChunkItr,
+						ChunkItr + DeltaAxis1,
+						ChunkItr + DeltaAxis2,
+						ChunkItr + DeltaAxis1 + DeltaAxis2
+					);
+
+					i = Start + Width;
+				}
+			}
+
+			Swap(CurrentLayer, CompareLayer);
+			bCurrentLayerBuilt = true;
+		}
+	}
+}
+
+
+void FGreedyMesher::CreateQuad(
+	const FMask Mask,
+	const FIntVector AxisMask,
+	const int Width,
+	const int Height,
+	const FIntVector V1,
+	const FIntVector V2,
+	const FIntVector V3,
+	const FIntVector V4
+)
+{
+	const auto Normal = FVector(AxisMask * Mask.Normal);
+	
+	// Get the material index for this block type
+	const int32 MaterialIndex = GetMaterialIndex(Mask.Block, Normal);
+	
+	// Make sure we have enough space in our per-material arrays
+	if (MaterialIndex >= MeshPerMaterial.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Material index %d is out of bounds! Max is %d"), MaterialIndex, MeshPerMaterial.Num());
+		return;
+	}
+	
+	// Add the vertices to the appropriate material's mesh data
+	const int32 CurrentVertexCount = VertexCountPerMat[MaterialIndex];
+	
+	MeshPerMaterial[MaterialIndex].Vertices.Append({
+		FVector(V1) * 100,
+		FVector(V2) * 100,
+		FVector(V3) * 100,
+		FVector(V4) * 100
+	});
+
+	MeshPerMaterial[MaterialIndex].Triangles.Append({
+		CurrentVertexCount,
+		CurrentVertexCount + 2 + Mask.Normal,
+		CurrentVertexCount + 2 - Mask.Normal,
+		CurrentVertexCount + 3,
+		CurrentVertexCount + 1 - Mask.Normal,
+		CurrentVertexCount + 1 + Mask.Normal
+	});
+
+	MeshPerMaterial[MaterialIndex].Normals.Append({
+		Normal,
+		Normal,
+		Normal,
+		Normal
+	});
+
+	const auto Color = FColor(0, 0, 0, GetTextureIndex(Mask.Block, Normal, V1));
+	MeshPerMaterial[MaterialIndex].Colors.Append({
+		Color,
+		Color,
+		Color,
+		Color
+	});
+
+	if (Normal.X == 1 || Normal.X == -1)
+	{
+		MeshPerMaterial[MaterialIndex].UV0.Append({
+			FVector2D(Width, Height),
+			FVector2D(0, Height),
+			FVector2D(Width, 0),
+			FVector2D(0, 0),
+		});
+	}
+	else
+	{
+		MeshPerMaterial[MaterialIndex].UV0.Append({
+			FVector2D(Height, Width),
+			FVector2D(Height, 0),
+			FVector2D(0, Width),
+			FVector2D(0, 0),
+		});
+	}
+
+	VertexCountPerMat [MaterialIndex] += 4;
+}
+
+bool FGreedyMesher::CompareMask(const FMask M1, const FMask M2)
+{
+	return M1.Block == M2.Block && M1.Normal == M2.Normal;
+}
+
+inline bool AreVectorsClose(const FVector& A, const FVector& B, float Tolerance = 0.0001f)
+{
+	return FVector::DistSquared(A, B) < FMath::Square(Tolerance);
+}
+
+int32 FGreedyMesher::GetMaterialIndex(const EBlock Block, const FVector& Normal)
+{
+	if (Block == EBlock::Null || Block == EBlock::Air)
+		return 0;
+	switch (Block) {
+	case EBlock::Grass:
+	case EBlock::Dirt:
+	case EBlock::Stone:
+	case EBlock::Log:
+	case EBlock::Sand:
+	case EBlock::Cactus:
+	case EBlock::Snow:
+	case EBlock::Sandstone:
+		return 0; // These blocks use material 0
+        
+	case EBlock::Leaves:
+	case EBlock::Water:
+		return 1; // Leaves use material 1
+        
+	default:
+		UE_LOG(LogTemp, Warning, TEXT("Unknown block type encountered in GetMaterialIndex!"));
+		return 0; // Default material 
+	}
+}
+
+int FGreedyMesher::GetTextureIndex(const EBlock Block, const FVector& Normal, const FIntVector& BlockPos) const
+{
+	switch (Block)
+	{
+	case EBlock::Grass:
+		{
+			if (AreVectorsClose(Normal, FVector::UpVector)) return 0;
+			if (AreVectorsClose(Normal, FVector::DownVector)) return 2;
+			return 1;
+		}
+	case EBlock::Dirt:
+		return 2; 
+	case EBlock::Stone:
+		return 3; 
+	case EBlock::Log:
+		{
+			if (AreVectorsClose(Normal, FVector::UpVector)) return 4; 
+			if (AreVectorsClose(Normal, FVector::DownVector)) return 4;
+			return 5;
+		}
+	case EBlock::Leaves:
+		{
+			return 6;
+		}
+	case EBlock::Sand:
+		{
+			return 7; // Sand texture for all faces
+		}
+	case EBlock::Snow:
+		{
+			return 8; // Snow texture for all faces
+		}
+	case EBlock::Cactus:
+		{
+			if (AreVectorsClose(Normal, FVector::UpVector)) // Top face
+			{
+				// Use the original top cactus texture if it was tagged during generation
+				if (Snapshot.OriginalTopCactusBlocks.Contains(BlockPos))
+					return 9;
+				else
+					return 10;
+			}
+			else if (AreVectorsClose(Normal, FVector::DownVector))
+			{
+				return 10;
+			}
+			else
+			{
+				return 11;
+			}
+		}
+	case  EBlock::Sandstone:
+		{
+			return 12;
+		}
+	case EBlock::Water:
+		{
+			return 13;
+		}
+
+	default:
+		 UE_LOG(LogTemp, Warning, TEXT("Unknown block type encountered in GetTextureIndex! Block: %s"), *UEnum::GetValueAsString(Block));
+			return 255; 
+	}
+}
+
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Voxel_Craft/Utils/ChunkMeshData.h"
+#include "Voxel_Craft/Utils/ChunkVoxelData.h"
+#include "Voxel_Craft/Utils/Enums.h"
+
+/**
+ * FChunkMeshSnapshot
+ * Immutable copy of everything the greedy mesher reads, stored as a padded
+ * (X+2)x(Y+2)x(Z+2) volume: the chunk's blocks plus one voxel of neighbor data (or air)
+ * on every side. The mesher only does array indexing on it, and since it never touches
+ * the live chunk, edits and the water simulator can keep mutating blocks meanwhile.
+ * Quiet sections (one block type, with the neighbor border beside them holding the same
+ * block) can't produce faces inside them, so the mesher skips them, and it never sweeps
+ * past the occupied layers.
+ */
+struct FChunkMeshSnapshot
+{
+	// Unpadded chunk size
+	FIntVector Size = FIntVector::ZeroValue;
+
+	TArray<EBlock> Blocks;
+
+	TSet<FIntVector> OriginalTopCactusBlocks;
+
+	// Per vertical section, the block filling a quiet section or Null when it has to be meshed
+	TArray<EBlock> QuietSections;
+
+	// Blocks filling the padding layers below and above the chunk, Null when a vertical neighbor's layer there is mixed
+	EBlock PaddingBelow = EBlock::Air;
+	EBlock PaddingAbove = EBlock::Air;
+
+	// Layers holding anything but air, padding beside the chunk included. Faces only exist from OccupiedMinZ - 1 to
+	// OccupiedMaxZ + 1, so the mesher sweeps no further. Min > Max when there is nothing to mesh
+	int32 OccupiedMinZ = 0;
+	int32 OccupiedMaxZ = -1;
+
+	// Sizes the padded volume for a chunk and fills it with air
+	void Init(const FIntVector& InSize);
+
+	// Index of a local position in the padded volume, valid from -1 to Size on each axis
+	int32 GetPaddedIndex(const FIntVector& LocalPos) const;
+
+	// Index distance between two voxels one step apart along Axis
+	int32 GetStride(int Axis) const;
+
+	EBlock GetBlock(const FIntVector& LocalPos) const { return Blocks[GetPaddedIndex(LocalPos)]; }
+
+	// Block filling the quiet section that holds layer Z, Null if it isn't quiet. Padding layers report PaddingBelow and PaddingAbove
+	EBlock GetQuietBlock(int32 Z) const;
+
+	bool IsQuietLayer(int32 Z) const { return GetQuietBlock(Z) != EBlock::Null; }
+
+	// No faces between layers Z and Z+1
+	bool IsQuietPair(int32 Z) const;
+
+	int32 GetSectionCount() const { return QuietSections.Num(); }
+};
+
+inline void FChunkMeshSnapshot::Init(const FIntVector& InSize)
+{
+	Size = InSize;
+	Blocks.Init(EBlock::Air, (Size.X + 2) * (Size.Y + 2) * (Size.Z + 2));
+	OriginalTopCactusBlocks.Empty();
+	QuietSections.Init(EBlock::Null, FMath::DivideAndRoundUp(Size.Z, FChunkVoxelData::SectionHeight));
+	PaddingBelow = EBlock::Air;
+	PaddingAbove = EBlock::Air;
+	OccupiedMinZ = 0;
+	OccupiedMaxZ = Size.Z - 1;
+}
+
+inline int32 FChunkMeshSnapshot::GetPaddedIndex(const FIntVector& LocalPos) const
+{
+	return (LocalPos.Z + 1) * (Size.Y + 2) * (Size.X + 2) + (LocalPos.Y + 1) * (Size.X + 2) + (LocalPos.X + 1);
+}
+
+inline int32 FChunkMeshSnapshot::GetStride(const int Axis) const
+{
+	switch (Axis)
+	{
+	case 0: return 1;
+	case 1: return Size.X + 2;
+	default: return (Size.X + 2) * (Size.Y + 2);
+	}
+}
+
+inline EBlock FChunkMeshSnapshot::GetQuietBlock(const int32 Z) const
+{
+	if (Z < 0) return PaddingBelow;
+	if (Z >= Size.Z) return PaddingAbove;
+	return QuietSections[Z / FChunkVoxelData::SectionHeight];
+}
+
+inline bool FChunkMeshSnapshot::IsQuietPair(const int32 Z) const
+{
+	const EBlock Block = GetQuietBlock(Z);
+	return Block != EBlock::Null && Block == GetQuietBlock(Z + 1);
+}
+
+/**
+ * FGreedyMesher
+ * Greedy meshes an FChunkMeshSnapshot into one FChunkMeshData per material slot and
+ * section, so a single section can be rebuilt on its own after an edit.
+ * Safe to run on a worker thread. The binary path builds the same quads as the scalar
+ * one from per block type bit planes, using bitwise ops for face culling and
+ * count-trailing-zeros to find and merge runs.
+ */
+class FGreedyMesher
+{
+public:
+	static constexpr int32 MaterialCount = 2;
+
+	explicit FGreedyMesher(const FChunkMeshSnapshot& InSnapshot);
+
+	// Meshes the whole chunk: MaterialCount mesh data per section, section after section
+	TArray<FChunkMeshData> GenerateMesh(EMeshingAlgorithm Algorithm);
+
+	// Meshes the faces one section owns, its layers plus the face plane below them (and the top of the chunk for the last section)
+	TArray<FChunkMeshData> GenerateSectionMesh(EMeshingAlgorithm Algorithm, int32 Section);
+
+private:
+	struct FMask
+	{
+		EBlock Block;
+		int Normal;
+	};
+
+	const FChunkMeshSnapshot& Snapshot;
+
+	TArray<FChunkMeshData> MeshPerMaterial;
+
+	TArray<int32> VertexCountPerMat;
+
+	// Greedy mesh the box [Begin, End) into MeshPerMaterial
+	void GenerateMeshScalar(const FIntVector& Begin, const FIntVector& End);
+	void GenerateMeshBinary(const FIntVector& Begin, const FIntVector& End);
+	void CreateQuad(FMask Mask, FIntVector AxisMask, int Width, int Height, FIntVector V1, FIntVector V2, FIntVector V3, FIntVector V4);
+	static bool CompareMask(FMask M1, FMask M2);
+	static int32 GetMaterialIndex(EBlock Block, const FVector& Normal);
+	int GetTextureIndex(EBlock Block, const FVector& Normal, const FIntVector& BlockPos) const;
+};
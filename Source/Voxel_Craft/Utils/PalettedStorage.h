@@ -0,0 +1,236 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * TPalettedStorage
+ * Fixed size array of byte sized values (blocks, meta) stored as a palette of the distinct
+ * values plus one bit-packed palette index per entry. Index width is 0, 1, 2, 4 or 8 bits
+ * and grows as new values are written, so a chunk of air and stone costs 1 bit per voxel
+ * and a single valued array costs nothing beyond its inline palette.
+ */
+template <typename ValueType>
+class TPalettedStorage
+{
+	static_assert(sizeof(ValueType) == 1, "TPalettedStorage packs indices for byte sized values only");
+
+public:
+	// Sizes the storage to InNum entries, all set to Value
+	void Init(int32 InNum, ValueType Value);
+
+	int32 Num() const { return NumEntries; }
+
+	// True when every entry holds the same value, at least since the last Compact
+	bool IsUniform() const { return BitsPerEntry == 0; }
+
+	ValueType Get(int32 Index) const;
+
+	void Set(int32 Index, ValueType Value);
+
+	// Sets Count consecutive entries to Value, covering every entry resets to a single value
+	void Fill(int32 Start, int32 Count, ValueType Value);
+
+	// Sets Count consecutive entries from Values, looking the palette up once per run of equal values
+	void SetRange(int32 Start, int32 Count, const ValueType* Values);
+
+	// Decodes Count consecutive entries into Out
+	void GetRange(int32 Start, int32 Count, ValueType* Out) const;
+
+	// Drops palette entries that are no longer referenced and shrinks the index width to match
+	void Compact();
+
+private:
+	int32 NumEntries = 0;
+
+	int32 BitsPerEntry = 0;
+
+	TArray<ValueType, TInlineAllocator<16>> Palette;
+
+	TArray<uint64> Words;
+
+	static int32 GetBitsForPaletteSize(int32 PaletteSize);
+
+	// Palette index of Value, added (and the indices widened) when it isn't in the palette yet
+	uint32 FindOrAddPaletteIndex(ValueType Value);
+
+	uint32 GetPaletteIndex(int32 Index) const;
+	void SetPaletteIndex(int32 Index, uint32 PaletteIndex);
+
+	// Re-encodes every entry at NewBits, mapping old palette indices through Remap when given
+	void Repack(int32 NewBits, const TArray<uint32>* Remap = nullptr);
+};
+
+template <typename ValueType>
+void TPalettedStorage<ValueType>::Init(const int32 InNum, const ValueType Value)
+{
+	NumEntries = InNum;
+	BitsPerEntry = 0;
+	Palette.Reset();
+	Palette.Add(Value);
+	Words.Empty();
+}
+
+template <typename ValueType>
+ValueType TPalettedStorage<ValueType>::Get(const int32 Index) const
+{
+	checkSlow(Index >= 0 && Index < NumEntries);
+	return Palette[GetPaletteIndex(Index)];
+}
+
+template <typename ValueType>
+void TPalettedStorage<ValueType>::Set(const int32 Index, const ValueType Value)
+{
+	checkSlow(Index >= 0 && Index < NumEntries);
+
+	SetPaletteIndex(Index, FindOrAddPaletteIndex(Value));
+}
+
+template <typename ValueType>
+void TPalettedStorage<ValueType>::Fill(const int32 Start, const int32 Count, const ValueType Value)
+{
+	checkSlow(Start >= 0 && Count >= 0 && Start + Count <= NumEntries);
+
+	if (Count == NumEntries)
+	{
+		Init(NumEntries, Value);
+		return;
+	}
+
+	const uint32 PaletteIndex = FindOrAddPaletteIndex(Value);
+	if (BitsPerEntry == 0) return;
+
+	for (int32 i = Start; i < Start + Count; ++i)
+	{
+		SetPaletteIndex(i, PaletteIndex);
+	}
+}
+
+template <typename ValueType>
+void TPalettedStorage<ValueType>::SetRange(const int32 Start, const int32 Count, const ValueType* Values)
+{
+	checkSlow(Start >= 0 && Count >= 0 && Start + Count <= NumEntries);
+
+	int32 i = 0;
+	while (i < Count)
+	{
+		int32 RunEnd = i + 1;
+		while (RunEnd < Count && Values[RunEnd] == Values[i]) ++RunEnd;
+
+		const uint32 PaletteIndex = FindOrAddPaletteIndex(Values[i]);
+		for (; i < RunEnd; ++i)
+		{
+			SetPaletteIndex(Start + i, PaletteIndex);
+		}
+	}
+}
+
+template <typename ValueType>
+void TPalettedStorage<ValueType>::GetRange(const int32 Start, const int32 Count, ValueType* Out) const
+{
+	checkSlow(Start >= 0 && Start + Count <= NumEntries);
+
+	if (BitsPerEntry == 0)
+	{
+		for (int32 i = 0; i < Count; ++i) Out[i] = Palette[0];
+		return;
+	}
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Out[i] = Palette[GetPaletteIndex(Start + i)];
+	}
+}
+
+template <typename ValueType>
+void TPalettedStorage<ValueType>::Compact()
+{
+	if (Palette.Num() <= 1) return;
+
+	TArray<bool> Used;
+	Used.Init(false, Palette.Num());
+	for (int32 i = 0; i < NumEntries; ++i)
+	{
+		Used[GetPaletteIndex(i)] = true;
+	}
+
+	TArray<ValueType, TInlineAllocator<16>> NewPalette;
+	TArray<uint32> Remap;
+	Remap.Init(0, Palette.Num());
+	for (int32 i = 0; i < Palette.Num(); ++i)
+	{
+		if (Used[i])
+		{
+			Remap[i] = NewPalette.Add(Palette[i]);
+		}
+	}
+
+	if (NewPalette.Num() == Palette.Num()) return;
+
+	Repack(GetBitsForPaletteSize(NewPalette.Num()), &Remap);
+	Palette = MoveTemp(NewPalette);
+}
+
+template <typename ValueType>
+int32 TPalettedStorage<ValueType>::GetBitsForPaletteSize(const int32 PaletteSize)
+{
+	// Power of two widths so an entry never straddles two words
+	if (PaletteSize <= 1) return 0;
+	return static_cast<int32>(FMath::RoundUpToPowerOfTwo(FMath::CeilLogTwo(static_cast<uint32>(PaletteSize))));
+}
+
+template <typename ValueType>
+uint32 TPalettedStorage<ValueType>::FindOrAddPaletteIndex(const ValueType Value)
+{
+	int32 PaletteIndex = Palette.Find(Value);
+	if (PaletteIndex == INDEX_NONE)
+	{
+		PaletteIndex = Palette.Add(Value);
+
+		const int32 NeededBits = GetBitsForPaletteSize(Palette.Num());
+		if (NeededBits != BitsPerEntry)
+		{
+			Repack(NeededBits);
+		}
+	}
+	return static_cast<uint32>(PaletteIndex);
+}
+
+template <typename ValueType>
+uint32 TPalettedStorage<ValueType>::GetPaletteIndex(const int32 Index) const
+{
+	if (BitsPerEntry == 0) return 0;
+
+	const int32 Bit = Index * BitsPerEntry;
+	return static_cast<uint32>(Words[Bit >> 6] >> (Bit & 63)) & ((1u << BitsPerEntry) - 1);
+}
+
+template <typename ValueType>
+void TPalettedStorage<ValueType>::SetPaletteIndex(const int32 Index, const uint32 PaletteIndex)
+{
+	if (BitsPerEntry == 0) return;
+
+	const int32 Bit = Index * BitsPerEntry;
+	const uint64 Mask = ((uint64(1) << BitsPerEntry) - 1) << (Bit & 63);
+	uint64& Word = Words[Bit >> 6];
+	Word = (Word & ~Mask) | (uint64(PaletteIndex) << (Bit & 63));
+}
+
+template <typename ValueType>
+void TPalettedStorage<ValueType>::Repack(const int32 NewBits, const TArray<uint32>* Remap)
+{
+	TArray<uint64> NewWords;
+	if (NewBits > 0)
+	{
+		NewWords.Init(0, static_cast<int32>((static_cast<int64>(NumEntries) * NewBits + 63) / 64));
+		for (int32 i = 0; i < NumEntries; ++i)
+		{
+			const uint32 OldIndex = GetPaletteIndex(i);
+			const uint32 NewIndex = Remap ? (*Remap)[OldIndex] : OldIndex;
+			const int32 Bit = i * NewBits;
+			NewWords[Bit >> 6] |= uint64(NewIndex) << (Bit & 63);
+		}
+	}
+
+	Words = MoveTemp(NewWords);
+	BitsPerEntry = NewBits;
+}
@@ -0,0 +1,991 @@
+#include "VoxelWorldGenerator.h"
+
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+FVoxelWorldGenerator::FVoxelWorldGenerator(const int32 InSeed, const float InFrequency, const FIntVector& InChunkSize, const bool bInCoarseHeights,
+                                           const int32 InDensitySampleSpacing)
+	: Seed(InSeed),
+	  ChunkSize(InChunkSize),
+	  bCoarseHeights(bInCoarseHeights),
+	  DensitySampleSpacing(FMath::Max(InDensitySampleSpacing, 1))
+{
+	Noise.SetSeed(Seed);
+	Noise.SetFrequency(InFrequency);
+	Noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+	Noise.SetFractalType(FastNoiseLite::FractalType_FBm);
+
+	// BiomeNoise keeps the FastNoiseLite defaults, matching what the greedy chunk has always sampled
+
+	RiverNoise.SetSeed(Seed + 1337); // unique river seed
+	RiverNoise.SetFrequency(0.009f * RiverNoiseScale); // low frequency = longer, wider rivers
+	RiverNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+	RiverNoise.SetFractalType(FastNoiseLite::FractalType_FBm);
+	RiverNoise.SetFractalOctaves(4);
+
+	LakeNoise.SetSeed(Seed + 42);
+	LakeNoise.SetFrequency(0.001f);
+	LakeNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+	LakeNoise.SetFractalType(FastNoiseLite::FractalType_FBm);
+	LakeNoise.SetFractalOctaves(4);
+
+	BiomeSettingsMap.Add(EBiomeType::Desert,   {0.01f, 0.2f, -5.0f, 4});
+	BiomeSettingsMap.Add(EBiomeType::Plains,   {0.02f, 0.4f, 0.0f, 4});
+	BiomeSettingsMap.Add(EBiomeType::Forest,   {0.02f, 0.5f, 2.0f, 4});
+	BiomeSettingsMap.Add(EBiomeType::Mountain, {0.005f, 1.2f, 10.0f, 4});
+	BiomeSettingsMap.Add(EBiomeType::Snowy,    {0.007f, 1.0f, 12.0f, 4});
+
+	InfluenceCurve.SetNumUninitialized(InfluenceCurveResolution + 1);
+	for (int32 i = 0; i <= InfluenceCurveResolution; ++i)
+	{
+		InfluenceCurve[i] = FMath::Pow(static_cast<float>(i) / InfluenceCurveResolution, 2.5f);
+	}
+}
+
+void FVoxelWorldGenerator::Generate(FChunkVoxelData& Data, const FVector& Position, const EGenerationType GenerationType,
+                                    const EGenerationStage Stages) const
+{
+	Data.Init(ChunkSize);
+
+	switch (GenerationType)
+	{
+	case EGenerationType::GT_3D:
+		{
+			// Density terrain is a single pass, counted as the fill
+			TRACE_CPUPROFILER_EVENT_SCOPE(VoxelGeneration_Density);
+			const FStageTimer Timer(*this, EGenerationStage::Fill);
+			Generate3D(Data, Position);
+		}
+		break;
+	case EGenerationType::GT_2D:
+		Generate2D(Data, Position, Stages);
+		break;
+	default:
+		checkNoEntry();
+	}
+
+	Data.Compact();
+
+	GeneratedChunkCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+double FVoxelWorldGenerator::GetStageMsPerChunk(const EGenerationStage Stage) const
+{
+	const uint32 Chunks = GeneratedChunkCount.load(std::memory_order_relaxed);
+	if (Chunks == 0) return 0.0;
+
+	return FPlatformTime::ToMilliseconds64(StageCycles[GetStageIndex(Stage)].load(std::memory_order_relaxed)) / Chunks;
+}
+
+FVoxelWorldGenerator::FStageTimer::FStageTimer(const FVoxelWorldGenerator& Generator, const EGenerationStage Stage)
+	: TotalCycles(Generator.StageCycles[GetStageIndex(Stage)]),
+	  StartCycles(FPlatformTime::Cycles64())
+{
+}
+
+FVoxelWorldGenerator::FStageTimer::~FStageTimer()
+{
+	TotalCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+}
+
+struct FBiomeRange
+{
+	float Min;
+	float Max;
+	EBiomeType Type;
+};
+
+const TArray<FBiomeRange> BiomeRanges = {
+	{0.0f, 0.2f, EBiomeType::Desert},
+	{0.2f, 0.4f, EBiomeType::Plains},
+	{0.4f, 0.6f, EBiomeType::Forest},
+	{0.6f, 0.8f, EBiomeType::Mountain},
+	{0.8f, 1.0f, EBiomeType::Snowy},
+};
+
+FBiomeNoiseSettings LerpBiomeSettings(const FBiomeNoiseSettings& A, const FBiomeNoiseSettings& B, float Alpha)
+{
+	FBiomeNoiseSettings Result;
+	Result.Frequency = FMath::Lerp(A.Frequency, B.Frequency, Alpha);
+	Result.Amplitude = FMath::Lerp(A.Amplitude, B.Amplitude, Alpha);
+	Result.Offset = FMath::Lerp(A.Offset, B.Offset, Alpha);
+	return Result;
+}
+
+
+
+FVoxelWorldGenerator::FColumnLattice FVoxelWorldGenerator::GetChunkLattice(const float X, const float Y, const int32 Spacing) const
+{
+	if (Spacing <= 1)
+	{
+		return {X, Y, 1, ChunkSize.X, ChunkSize.Y};
+	}
+
+	// Snap to world multiples of Spacing so neighbouring chunks sample the same points along their shared border
+	const float LatticeX = FMath::FloorToFloat(X / Spacing) * Spacing;
+	const float LatticeY = FMath::FloorToFloat(Y / Spacing) * Spacing;
+	const int32 OffsetX = static_cast<int32>(X - LatticeX);
+	const int32 OffsetY = static_cast<int32>(Y - LatticeY);
+
+	// One point past the last column so every column has a sample on both sides
+	return {LatticeX, LatticeY, Spacing, (OffsetX + ChunkSize.X - 1) / Spacing + 2, (OffsetY + ChunkSize.Y - 1) / Spacing + 2};
+}
+
+void FVoxelWorldGenerator::GetNoiseGrid2D(const FastNoiseLite& InNoise, const float X, const float Y, const float Scale, TArray<float>& Out) const
+{
+	GetNoiseGrid2D(InNoise, GetChunkLattice(X, Y, 1), Scale, Out);
+}
+
+void FVoxelWorldGenerator::GetNoiseGrid2D(const FastNoiseLite& InNoise, const FColumnLattice& Lattice, const float Scale, TArray<float>& Out) const
+{
+	Out.SetNumUninitialized(Lattice.Num());
+	const float Step = Lattice.Spacing * Scale;
+	InNoise.GetNoiseGrid2D(Out.GetData(), Lattice.X * Scale, Lattice.Y * Scale, Step, Step, Lattice.CountX, Lattice.CountY);
+}
+
+void FVoxelWorldGenerator::InterpolateGrid2D(const FColumnLattice& Lattice, const TArray<float>& Samples, const float X, const float Y, TArray<float>& Out) const
+{
+	Out.SetNumUninitialized(ChunkSize.X * ChunkSize.Y);
+
+	const int32 OffsetX = static_cast<int32>(X - Lattice.X);
+	const int32 OffsetY = static_cast<int32>(Y - Lattice.Y);
+	const float InvSpacing = 1.0f / Lattice.Spacing;
+
+	for (int32 y = 0; y < ChunkSize.Y; ++y)
+	{
+		const int32 CellY = (OffsetY + y) / Lattice.Spacing;
+		const float AlphaY = ((OffsetY + y) - CellY * Lattice.Spacing) * InvSpacing;
+		const float* Row0 = &Samples[CellY * Lattice.CountX];
+		const float* Row1 = Row0 + Lattice.CountX;
+
+		for (int32 x = 0; x < ChunkSize.X; ++x)
+		{
+			const int32 CellX = (OffsetX + x) / Lattice.Spacing;
+			const float AlphaX = ((OffsetX + x) - CellX * Lattice.Spacing) * InvSpacing;
+
+			const float Near = FMath::Lerp(Row0[CellX], Row0[CellX + 1], AlphaX);
+			const float Far = FMath::Lerp(Row1[CellX], Row1[CellX + 1], AlphaX);
+			Out[y * ChunkSize.X + x] = FMath::Lerp(Near, Far, AlphaY);
+		}
+	}
+}
+
+void FVoxelWorldGenerator::GetFractalNoiseGrid2D(const FastNoiseLite& InNoise, const FColumnLattice& Lattice, const float Frequency, const int Octaves,
+                                                 const float Persistence, TMap<float, TArray<float>>& OctaveGrids, TArray<float>& Out) const
+{
+	Out.Init(0.0f, Lattice.Num());
+
+	float MaxValue = 0.0f;
+	float Amplitude = 1.0f;
+	float Freq = Frequency;
+
+	for (int i = 0; i < Octaves; ++i)
+	{
+		const TArray<float>* Octave = OctaveGrids.Find(Freq);
+		if (!Octave)
+		{
+			TArray<float>& NewOctave = OctaveGrids.Add(Freq);
+			GetNoiseGrid2D(InNoise, Lattice, Freq, NewOctave);
+			Octave = &NewOctave;
+		}
+
+		for (int32 Column = 0; Column < Out.Num(); ++Column)
+		{
+			Out[Column] += (*Octave)[Column] * Amplitude;
+		}
+
+		MaxValue += Amplitude;
+		Amplitude *= Persistence;
+		Freq *= 2.0f;
+	}
+
+	for (float& Value : Out)
+	{
+		Value /= MaxValue;
+	}
+}
+
+int32 FVoxelWorldGenerator::BlendColumnHeight(const float* Influences, const float* HeightNoise, const float Detail, EBiomeType& OutDominantBiome) const
+{
+	float HeightSum = 0.0f;
+	float WeightSum = 0.0f;
+
+	OutDominantBiome = EBiomeType::Plains; // Default biome
+	float MaxInfluence = 0.0f;
+
+	// Multi-biome height blending
+	for (int32 RangeIndex = 0; RangeIndex < BiomeRanges.Num(); ++RangeIndex)
+	{
+		const FBiomeRange& Range = BiomeRanges[RangeIndex];
+		const float Influence = Influences[RangeIndex];
+
+		if (Influence <= 0.001f) continue;
+
+		if (Influence > MaxInfluence)
+		{
+			MaxInfluence = Influence;
+			OutDominantBiome = Range.Type;
+		}
+
+		const FBiomeNoiseSettings& Settings = BiomeSettingsMap[Range.Type];
+
+		float BiomeHeight = (HeightNoise[RangeIndex] + 1.0f) * 0.5f * Settings.Amplitude * ChunkSize.Z + Settings.Offset;
+
+		HeightSum += BiomeHeight * Influence;
+		WeightSum += Influence;
+	}
+
+	// Ensure we have at least some influence
+	if (WeightSum < 0.0001f)
+	{
+		WeightSum = 1.0f;
+		HeightSum = 30.0f; // Default height if no biome influence
+		OutDominantBiome = EBiomeType::Plains;
+	}
+
+	float FinalHeight = HeightSum / WeightSum;
+
+	// Add small-scale noise for terrain details
+	FinalHeight += Detail * 1.5f;
+
+	// Ensure minimum terrain height for digging (at least 15 blocks deep)
+	constexpr int MinimumHeight = 50;
+	return FMath::Clamp(FMath::RoundToInt(FinalHeight), MinimumHeight, ChunkSize.Z - 1);
+}
+
+float FVoxelWorldGenerator::GetBiomeHeightNoise(const FBiomeNoiseSettings& Settings, const float WorldX, const float WorldY) const
+{
+	const auto SampleFractal = [this, &Settings](const float X, const float Y)
+	{
+		float NoiseValue = 0.0f;
+		float MaxValue = 0.0f;
+		float Amplitude = 1.0f;
+		float Freq = Settings.Frequency;
+		for (int i = 0; i < 4; ++i)
+		{
+			NoiseValue += Noise.GetNoise(X * Freq, Y * Freq) * Amplitude;
+			MaxValue += Amplitude;
+			Amplitude *= 0.5f;
+			Freq *= 2.0f;
+		}
+		return NoiseValue / MaxValue;
+	};
+
+	const int32 Spacing = bCoarseHeights ? Settings.HeightSampleSpacing : 1;
+	if (Spacing <= 1)
+	{
+		return SampleFractal(WorldX, WorldY);
+	}
+
+	// The four lattice points around the column, blended the way InterpolateGrid2D blends them
+	const float CellX = FMath::FloorToFloat(WorldX / Spacing) * Spacing;
+	const float CellY = FMath::FloorToFloat(WorldY / Spacing) * Spacing;
+	const float InvSpacing = 1.0f / Spacing;
+	const float AlphaX = (WorldX - CellX) * InvSpacing;
+	const float AlphaY = (WorldY - CellY) * InvSpacing;
+
+	const float Near = FMath::Lerp(SampleFractal(CellX, CellY), SampleFractal(CellX + Spacing, CellY), AlphaX);
+	const float Far = FMath::Lerp(SampleFractal(CellX, CellY + Spacing), SampleFractal(CellX + Spacing, CellY + Spacing), AlphaX);
+	return FMath::Lerp(Near, Far, AlphaY);
+}
+
+int32 FVoxelWorldGenerator::GetSurfaceHeight(const float WorldX, const float WorldY) const
+{
+	// Same blend and height lattice as ComputeColumns, for a single column
+	const float NormalizedBiomeValue = (BiomeNoise.GetNoise(WorldX * 0.05f, WorldY * 0.05f) + 1.0f) * 0.5f;
+
+	TArray<float, TInlineAllocator<8>> Influences;
+	TArray<float, TInlineAllocator<8>> HeightNoise;
+	Influences.SetNumUninitialized(BiomeRanges.Num());
+	HeightNoise.SetNumUninitialized(BiomeRanges.Num());
+
+	for (int32 RangeIndex = 0; RangeIndex < BiomeRanges.Num(); ++RangeIndex)
+	{
+		const FBiomeRange& Range = BiomeRanges[RangeIndex];
+		const float Mid = (Range.Min + Range.Max) * 0.5f;
+		Influences[RangeIndex] = GetBiomeInfluence(FMath::Clamp(1.0f - FMath::Abs(NormalizedBiomeValue - Mid) * 5.0f, 0.0f, 1.0f));
+		HeightNoise[RangeIndex] = Influences[RangeIndex] > 0.001f ? GetBiomeHeightNoise(BiomeSettingsMap[Range.Type], WorldX, WorldY) : 0.0f;
+	}
+
+	EBiomeType DominantBiome;
+	return BlendColumnHeight(Influences.GetData(), HeightNoise.GetData(), Noise.GetNoise(WorldX * 0.1f, WorldY * 0.1f), DominantBiome);
+}
+
+void FVoxelWorldGenerator::GetLakes(const int32 MinX, const int32 MinY, const int32 MaxX, const int32 MaxY, TArray<FLake>& Out) const
+{
+	// One candidate lake per LakeCellSize cell of the world
+	const int32 CellMinX = FMath::FloorToInt(static_cast<float>(MinX - MaxLakeReach) / LakeCellSize);
+	const int32 CellMinY = FMath::FloorToInt(static_cast<float>(MinY - MaxLakeReach) / LakeCellSize);
+	const int32 CellMaxX = FMath::FloorToInt(static_cast<float>(MaxX + MaxLakeReach) / LakeCellSize);
+	const int32 CellMaxY = FMath::FloorToInt(static_cast<float>(MaxY + MaxLakeReach) / LakeCellSize);
+
+	for (int32 CellY = CellMinY; CellY <= CellMaxY; ++CellY)
+	{
+		for (int32 CellX = CellMinX; CellX <= CellMaxX; ++CellX)
+		{
+			// Seeded by cell, every chunk the lake touches places it identically
+			const FRandomStream LakeRand(FMath::Abs(Seed + 42) ^ (CellX * 73856093) ^ (CellY * 19349663));
+			if (LakeRand.FRand() > LakeChance) continue;
+
+			FLake Lake;
+			Lake.CenterX = CellX * LakeCellSize + LakeRand.RandRange(0, LakeCellSize - 1);
+			Lake.CenterY = CellY * LakeCellSize + LakeRand.RandRange(0, LakeCellSize - 1);
+			Lake.Radius = LakeRand.RandRange(8, MaxLakeRadius);
+
+			// Lakes only form in the low areas of the lake noise
+			if (LakeNoise.GetNoise(static_cast<float>(Lake.CenterX), static_cast<float>(Lake.CenterY)) >= -0.35f) continue;
+
+			// The "ideal" water level, taken from the center column even when it lies in another chunk
+			Lake.WaterLevel = GetSurfaceHeight(static_cast<float>(Lake.CenterX), static_cast<float>(Lake.CenterY));
+			if (Lake.WaterLevel >= ChunkSize.Z * 0.8f) continue;
+
+			Out.Add(Lake);
+		}
+	}
+}
+
+bool FVoxelWorldGenerator::IsInsideLake(const FLake& Lake, const int32 WorldX, const int32 WorldY) const
+{
+	const float DeltaX = static_cast<float>(WorldX - Lake.CenterX);
+	const float DeltaY = static_cast<float>(WorldY - Lake.CenterY);
+	const float Distance = FMath::Sqrt(DeltaX * DeltaX + DeltaY * DeltaY);
+
+	// Only the band the shore can wobble through needs the rim noise
+	if (Distance >= Lake.Radius + LakeRimNoise) return false;
+	if (Distance < Lake.Radius - LakeRimNoise) return true;
+
+	const float Angle = FMath::Atan2(DeltaY, DeltaX);
+	const float RimRadius = Lake.Radius + LakeNoise.GetNoise(
+		Lake.CenterX + FMath::Cos(Angle) * Lake.Radius,
+		Lake.CenterY + FMath::Sin(Angle) * Lake.Radius) * LakeRimNoise;
+
+	return Distance < RimRadius;
+}
+
+EBiomeType FVoxelWorldGenerator::GetDominantBiome(const float WorldX, const float WorldY) const
+{
+	const float NormalizedBiomeValue = (BiomeNoise.GetNoise(WorldX * 0.05f, WorldY * 0.05f) + 1.0f) * 0.5f;
+
+	EBiomeType DominantBiome = EBiomeType::Plains;
+	float MaxInfluence = 0.001f;
+
+	for (const FBiomeRange& Range : BiomeRanges)
+	{
+		const float Mid = (Range.Min + Range.Max) * 0.5f;
+		const float Influence = GetBiomeInfluence(FMath::Clamp(1.0f - FMath::Abs(NormalizedBiomeValue - Mid) * 5.0f, 0.0f, 1.0f));
+		if (Influence > MaxInfluence)
+		{
+			MaxInfluence = Influence;
+			DominantBiome = Range.Type;
+		}
+	}
+	return DominantBiome;
+}
+
+float FVoxelWorldGenerator::GetBiomeInfluence(const float Falloff) const
+{
+	const float Sample = Falloff * InfluenceCurveResolution;
+	const int32 Index = FMath::Min(static_cast<int32>(Sample), InfluenceCurveResolution - 1);
+	return FMath::Lerp(InfluenceCurve[Index], InfluenceCurve[Index + 1], Sample - Index);
+}
+
+void FVoxelWorldGenerator::Generate2D(FChunkVoxelData& Data, const FVector& Position, const EGenerationStage Stages) const
+{
+	// Every later stage reads the columns, so heights and biomes always run
+	FChunkColumns Columns;
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(VoxelGeneration_Height);
+		const FStageTimer Timer(*this, EGenerationStage::Height);
+		ComputeColumns(Position, Columns);
+	}
+
+	if (EnumHasAnyFlags(Stages, EGenerationStage::Fill))
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(VoxelGeneration_Fill);
+		const FStageTimer Timer(*this, EGenerationStage::Fill);
+		FillColumns(Data, Columns);
+	}
+
+	if (EnumHasAnyFlags(Stages, EGenerationStage::WaterBodies))
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(VoxelGeneration_WaterBodies);
+		const FStageTimer Timer(*this, EGenerationStage::WaterBodies);
+		PlaceLakes(Data, Columns);
+	}
+
+	if (EnumHasAnyFlags(Stages, EGenerationStage::Carving))
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(VoxelGeneration_Carving);
+		const FStageTimer Timer(*this, EGenerationStage::Carving);
+		CarveRivers(Data, Columns);
+	}
+
+	if (EnumHasAnyFlags(Stages, EGenerationStage::Decoration))
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(VoxelGeneration_Decoration);
+		const FStageTimer Timer(*this, EGenerationStage::Decoration);
+		PlaceStructures(Data, Columns);
+	}
+}
+
+void FVoxelWorldGenerator::ComputeColumns(const FVector& Position, FChunkColumns& Out) const
+{
+	// Every noise read per column samples the same lattice, so each one is a single batched grid
+	const float StartX = FMath::FloorToFloat(Position.X);
+	const float StartY = FMath::FloorToFloat(Position.Y);
+	const int32 ColumnCount = ChunkSize.X * ChunkSize.Y;
+
+	TArray<float> BiomeGrid;
+	GetNoiseGrid2D(BiomeNoise, StartX, StartY, 0.05f, BiomeGrid);
+
+	// Biome influence per column, indexed Column * BiomeRanges.Num() + RangeIndex; a biome's height noise is only
+	// sampled when it reaches into the chunk
+	TArray<float> Influences;
+	Influences.SetNumUninitialized(BiomeRanges.Num() * ColumnCount);
+	TArray<TArray<float>> BiomeHeightNoise;
+	BiomeHeightNoise.SetNum(BiomeRanges.Num());
+	// Octave grids shared between biomes, one set per sample spacing since each spacing has its own lattice
+	TMap<int32, TMap<float, TArray<float>>> OctaveGrids;
+	TArray<float> CoarseHeightNoise;
+
+	for (int32 RangeIndex = 0; RangeIndex < BiomeRanges.Num(); ++RangeIndex)
+	{
+		const FBiomeRange& Range = BiomeRanges[RangeIndex];
+		const float Mid = (Range.Min + Range.Max) * 0.5f;
+		bool bReachesChunk = false;
+
+		for (int32 Column = 0; Column < ColumnCount; ++Column)
+		{
+			// Normalize biome noise to 0.0-1.0 range
+			const float NormalizedBiomeValue = (BiomeGrid[Column] + 1.0f) * 0.5f;
+			float Distance = FMath::Abs(NormalizedBiomeValue - Mid);
+			float Influence = FMath::Clamp(1.0f - Distance * 5.0f, 0.0f, 1.0f); // Weight falloff
+			Influence = GetBiomeInfluence(Influence); // Smoother falloff (adjusted from 3)
+
+			Influences[Column * BiomeRanges.Num() + RangeIndex] = Influence;
+			bReachesChunk |= Influence > 0.001f;
+		}
+
+		if (bReachesChunk)
+		{
+			// Height noise is smooth at biome frequencies, so it can be sampled every few columns and interpolated
+			const FBiomeNoiseSettings& Settings = BiomeSettingsMap[Range.Type];
+			const int32 Spacing = bCoarseHeights ? Settings.HeightSampleSpacing : 1;
+			const FColumnLattice Lattice = GetChunkLattice(StartX, StartY, Spacing);
+			TMap<float, TArray<float>>& SpacingOctaves = OctaveGrids.FindOrAdd(Lattice.Spacing);
+
+			if (Lattice.Spacing == 1)
+			{
+				GetFractalNoiseGrid2D(Noise, Lattice, Settings.Frequency, 4, 0.5f, SpacingOctaves, BiomeHeightNoise[RangeIndex]);
+			}
+			else
+			{
+				GetFractalNoiseGrid2D(Noise, Lattice, Settings.Frequency, 4, 0.5f, SpacingOctaves, CoarseHeightNoise);
+				InterpolateGrid2D(Lattice, CoarseHeightNoise, StartX, StartY, BiomeHeightNoise[RangeIndex]);
+			}
+		}
+	}
+
+	// Small-scale terrain detail
+	TArray<float> DetailGrid;
+	GetNoiseGrid2D(Noise, StartX, StartY, 0.1f, DetailGrid);
+
+	Out.ChunkMinX = static_cast<int32>(StartX);
+	Out.ChunkMinY = static_cast<int32>(StartY);
+	Out.Runs.SetNumUninitialized(ColumnCount);
+	Out.LowestRun = ChunkSize.Z;
+	Out.HighestSurface = -1;
+
+	// Height noise of one column per biome, zero for the biomes that don't reach the chunk
+	TArray<float, TInlineAllocator<8>> ColumnHeightNoise;
+	ColumnHeightNoise.SetNumZeroed(BiomeRanges.Num());
+
+	for (int x = 0; x < ChunkSize.X; x++)
+	{
+		for (int y = 0; y < ChunkSize.Y; y++)
+		{
+			const int32 Column = y * ChunkSize.X + x;
+
+			for (int32 RangeIndex = 0; RangeIndex < BiomeRanges.Num(); ++RangeIndex)
+			{
+				if (BiomeHeightNoise[RangeIndex].Num() > 0)
+				{
+					ColumnHeightNoise[RangeIndex] = BiomeHeightNoise[RangeIndex][Column];
+				}
+			}
+
+			EBiomeType DominantBiome;
+			const int Height = BlendColumnHeight(&Influences[Column * BiomeRanges.Num()], ColumnHeightNoise.GetData(), DetailGrid[Column], DominantBiome);
+
+			// Block layers as runs: stone, then the sub-surface block, then the top block up to Height
+			FColumnRuns& Runs = Out.Runs[Column];
+			Runs.Height = Height;
+			if (DominantBiome == EBiomeType::Desert)
+			{
+				// Desert stratified layering, 3 layers of sandstone under 3 of sand
+				Runs.MidStart = Height - 5;
+				Runs.TopStart = Height - 2;
+				Runs.MidBlock = EBlock::Sandstone;
+				Runs.TopBlock = EBlock::Sand;
+			}
+			else
+			{
+				// Underground layers, then the surface block based on biome
+				Runs.MidStart = Height - 3;
+				Runs.TopStart = Height;
+				Runs.MidBlock = EBlock::Dirt;
+				switch (DominantBiome)
+				{
+				case EBiomeType::Mountain: Runs.TopBlock = EBlock::Stone; break;
+				case EBiomeType::Snowy:    Runs.TopBlock = EBlock::Snow; break;
+				default:                   Runs.TopBlock = EBlock::Grass; break;
+				}
+			}
+
+			Out.LowestRun = FMath::Min(Out.LowestRun, FMath::Max(Runs.MidStart, 0));
+			Out.HighestSurface = FMath::Max(Out.HighestSurface, Height);
+		}
+	}
+
+	// Lakes centered in a neighbor chunk still reach in, so lakes cross chunk borders seamlessly. Gathered out to
+	// the reach of structures anchored next door, which also need to stay out of the water
+	GetLakes(Out.ChunkMinX - MaxStructureReach, Out.ChunkMinY - MaxStructureReach,
+	         Out.ChunkMinX + ChunkSize.X - 1 + MaxStructureReach, Out.ChunkMinY + ChunkSize.Y - 1 + MaxStructureReach, Out.Lakes);
+
+	// Rivers over the same area. Sampled at whole world columns, so every chunk gets the same value for a column
+	const FColumnLattice RiverLattice = {
+		StartX - MaxStructureReach, StartY - MaxStructureReach, 1,
+		ChunkSize.X + 2 * MaxStructureReach, ChunkSize.Y + 2 * MaxStructureReach};
+	GetNoiseGrid2D(RiverNoise, RiverLattice, 1.0f, Out.RiverField);
+	Out.RiverFieldWidth = RiverLattice.CountX;
+}
+
+void FVoxelWorldGenerator::FillColumns(FChunkVoxelData& Data, const FChunkColumns& Columns) const
+{
+	// Every column is stone below LowestRun, so those layers are filled in bulk and whole sections end up uniform.
+	// Above it the runs are written a Z layer at a time, which is contiguous in the chunk's X/Y-inner layout.
+	// Everything above HighestSurface is already air from Init
+	const int32 LayerSize = ChunkSize.X * ChunkSize.Y;
+	Data.FillBlocks(0, Columns.LowestRun * LayerSize, EBlock::Stone);
+
+	TArray<EBlock> Layer;
+	Layer.SetNumUninitialized(LayerSize);
+	for (int32 z = Columns.LowestRun; z <= Columns.HighestSurface; ++z)
+	{
+		for (int32 Column = 0; Column < LayerSize; ++Column)
+		{
+			const FColumnRuns& Runs = Columns.Runs[Column];
+			Layer[Column] = z < Runs.MidStart ? EBlock::Stone
+				: z < Runs.TopStart ? Runs.MidBlock
+				: z <= Runs.Height ? Runs.TopBlock
+				: EBlock::Air;
+		}
+		Data.SetBlockRange(Data.GetBlockIndex(0, 0, z), LayerSize, Layer.GetData());
+	}
+}
+
+void FVoxelWorldGenerator::PlaceLakes(FChunkVoxelData& Data, const FChunkColumns& Columns) const
+{
+	for (const FLake& Lake : Columns.Lakes)
+	{
+		// Scanline over the footprint's bounding box, clipped to this chunk
+		const int32 MinX = FMath::Max(Lake.CenterX - MaxLakeReach - Columns.ChunkMinX, 0);
+		const int32 MaxX = FMath::Min(Lake.CenterX + MaxLakeReach - Columns.ChunkMinX, ChunkSize.X - 1);
+		const int32 MinY = FMath::Max(Lake.CenterY - MaxLakeReach - Columns.ChunkMinY, 0);
+		const int32 MaxY = FMath::Min(Lake.CenterY + MaxLakeReach - Columns.ChunkMinY, ChunkSize.Y - 1);
+
+		for (int32 ly = MinY; ly <= MaxY; ++ly)
+		{
+			for (int32 lx = MinX; lx <= MaxX; ++lx)
+			{
+				if (!IsInsideLake(Lake, Columns.ChunkMinX + lx, Columns.ChunkMinY + ly)) continue;
+
+				// Never above the local surface, so water doesn't float over dips in the shore
+				const int32 SurfaceZ = Columns.Runs[ly * ChunkSize.X + lx].Height;
+				const int32 WaterLevel = FMath::Min(Lake.WaterLevel, SurfaceZ);
+
+				// Dig a depression (2 blocks deep), then fill with water
+				for (int32 lz = FMath::Max(WaterLevel - 2, 0); lz <= WaterLevel && lz < ChunkSize.Z; ++lz)
+				{
+					const int32 Index = Data.GetBlockIndex(lx, ly, lz);
+					const EBlock Block = Data.GetBlock(Index);
+					if (Block == EBlock::Air || Block == EBlock::Dirt || Block == EBlock::Grass || Block == EBlock::Sand)
+					{
+						Data.SetBlock(Index, EBlock::Water);
+						Data.SetMeta(Index, 0);
+					}
+				}
+			}
+		}
+	}
+}
+
+void FVoxelWorldGenerator::CarveRivers(FChunkVoxelData& Data, const FChunkColumns& Columns) const
+{
+	// Global, smooth, Minecraft-like rivers along the zero band of the river noise
+	for (int x = 0; x < ChunkSize.X; ++x) {
+		for (int y = 0; y < ChunkSize.Y; ++y) {
+			float riverNoise = FMath::Abs(Columns.GetRiverNoise(Columns.ChunkMinX + x, Columns.ChunkMinY + y));
+			if (riverNoise < RiverWidth) {
+				int z = Columns.Runs[y * ChunkSize.X + x].Height;
+
+				int riverBed = FMath::Max(z - 2, 0);
+				for (int dz = 0; dz <= 2; ++dz) {
+					int zz = riverBed + dz;
+					if (zz < ChunkSize.Z) {
+						int idx = Data.GetBlockIndex(x, y, zz);
+						if (dz < 2) Data.SetBlock(idx, EBlock::Dirt);
+						else        Data.SetBlock(idx, EBlock::Water);
+						Data.SetMeta(idx, 0);
+					}
+				}
+			}
+		}
+	}
+}
+
+void FVoxelWorldGenerator::Generate3D(FChunkVoxelData& Data, const FVector& Position) const
+{
+	TArray<float> Density;
+	GetDensityGrid(Position, ChunkSize, Density);
+
+	// Density is laid out like the chunk's blocks. Negative is solid, the rest stays air from Init
+	for (int32 Index = 0; Index < Density.Num(); ++Index)
+	{
+		if (Density[Index] < 0)
+		{
+			Data.SetBlock(Index, EBlock::Stone);
+		}
+	}
+}
+
+void FVoxelWorldGenerator::GetDensityGrid(const FVector& Origin, const FIntVector& Count, TArray<float>& Out) const
+{
+	Out.SetNumUninitialized(Count.X * Count.Y * Count.Z);
+
+	if (DensitySampleSpacing == 1)
+	{
+		Noise.GetNoiseGrid3D(Out.GetData(), Origin.X, Origin.Y, Origin.Z, 1.0f, 1.0f, 1.0f, Count.X, Count.Y, Count.Z);
+		return;
+	}
+
+	const int32 Spacing = DensitySampleSpacing;
+
+	// Snap to world multiples of Spacing so neighbouring chunks interpolate from the same samples
+	const FIntVector Start(FMath::FloorToInt(Origin.X), FMath::FloorToInt(Origin.Y), FMath::FloorToInt(Origin.Z));
+	const FIntVector LatticeStart(
+		FMath::FloorToInt(static_cast<float>(Start.X) / Spacing) * Spacing,
+		FMath::FloorToInt(static_cast<float>(Start.Y) / Spacing) * Spacing,
+		FMath::FloorToInt(static_cast<float>(Start.Z) / Spacing) * Spacing);
+	const FIntVector Offset = Start - LatticeStart;
+
+	// One sample past the last point so every point has a sample on both sides
+	const FIntVector LatticeCount(
+		(Offset.X + Count.X - 1) / Spacing + 2,
+		(Offset.Y + Count.Y - 1) / Spacing + 2,
+		(Offset.Z + Count.Z - 1) / Spacing + 2);
+
+	TArray<float> Samples;
+	Samples.SetNumUninitialized(LatticeCount.X * LatticeCount.Y * LatticeCount.Z);
+	Noise.GetNoiseGrid3D(Samples.GetData(), LatticeStart.X, LatticeStart.Y, LatticeStart.Z, Spacing, Spacing, Spacing,
+	                     LatticeCount.X, LatticeCount.Y, LatticeCount.Z);
+
+	const float InvSpacing = 1.0f / Spacing;
+	const int32 SampleStrideY = LatticeCount.X;
+	const int32 SampleStrideZ = LatticeCount.X * LatticeCount.Y;
+
+	// Lattice cell and blend weight of every X point, shared by all rows
+	TArray<int32> CellX;
+	TArray<float> AlphaX;
+	CellX.SetNumUninitialized(Count.X);
+	AlphaX.SetNumUninitialized(Count.X);
+	for (int32 x = 0; x < Count.X; ++x)
+	{
+		CellX[x] = (Offset.X + x) / Spacing;
+		AlphaX[x] = ((Offset.X + x) - CellX[x] * Spacing) * InvSpacing;
+	}
+
+	for (int32 z = 0; z < Count.Z; ++z)
+	{
+		const int32 CellZ = (Offset.Z + z) / Spacing;
+		const float AlphaZ = ((Offset.Z + z) - CellZ * Spacing) * InvSpacing;
+
+		for (int32 y = 0; y < Count.Y; ++y)
+		{
+			const int32 CellY = (Offset.Y + y) / Spacing;
+			const float AlphaY = ((Offset.Y + y) - CellY * Spacing) * InvSpacing;
+
+			// The four lattice rows around this row of points
+			const float* Row00 = &Samples[CellZ * SampleStrideZ + CellY * SampleStrideY];
+			const float* Row10 = Row00 + SampleStrideY;
+			const float* Row01 = Row00 + SampleStrideZ;
+			const float* Row11 = Row01 + SampleStrideY;
+			float* OutRow = &Out[(z * Count.Y + y) * Count.X];
+
+			for (int32 x = 0; x < Count.X; ++x)
+			{
+				const int32 Cell = CellX[x];
+				const float Alpha = AlphaX[x];
+
+				const float Bottom = FMath::Lerp(
+					FMath::Lerp(Row00[Cell], Row00[Cell + 1], Alpha),
+					FMath::Lerp(Row10[Cell], Row10[Cell + 1], Alpha), AlphaY);
+				const float Top = FMath::Lerp(
+					FMath::Lerp(Row01[Cell], Row01[Cell + 1], Alpha),
+					FMath::Lerp(Row11[Cell], Row11[Cell + 1], Alpha), AlphaY);
+				OutRow[x] = FMath::Lerp(Bottom, Top, AlphaZ);
+			}
+		}
+	}
+}
+
+void FVoxelWorldGenerator::PlaceStructures(FChunkVoxelData& Data, const FChunkColumns& Columns) const
+{
+	const int32 ChunkMinX = Columns.ChunkMinX;
+	const int32 ChunkMinY = Columns.ChunkMinY;
+
+	// A structure is decided from its anchor's world column alone, never from this chunk's voxels, so every chunk its
+	// bounds touch enumerates it identically and writes only the part inside itself. Neighbors don't need to be loaded
+	// and no chunk ever writes into another, so there is nothing to remesh afterwards.
+
+	// One candidate per VegetationCellSize cell of the world, jittered inside its cell and seeded by it. Candidates are
+	// kept in a small spatial hash by cell, one cell past any structure reaching the chunk for the spacing test
+	const FIntPoint CellMin(
+		FMath::FloorToInt(static_cast<float>(ChunkMinX - MaxStructureReach) / VegetationCellSize) - 1,
+		FMath::FloorToInt(static_cast<float>(ChunkMinY - MaxStructureReach) / VegetationCellSize) - 1);
+	const FIntPoint CellMax(
+		FMath::FloorToInt(static_cast<float>(ChunkMinX + ChunkSize.X - 1 + MaxStructureReach) / VegetationCellSize) + 1,
+		FMath::FloorToInt(static_cast<float>(ChunkMinY + ChunkSize.Y - 1 + MaxStructureReach) / VegetationCellSize) + 1);
+	const int32 CellsX = CellMax.X - CellMin.X + 1;
+
+	struct FVegetationCandidate
+	{
+		FIntPoint Position;
+		EBiomeType Biome;
+		float Priority;
+		bool bWanted;
+	};
+
+	TArray<FVegetationCandidate> Candidates;
+	Candidates.SetNumUninitialized(CellsX * (CellMax.Y - CellMin.Y + 1));
+
+	for (int32 CellY = CellMin.Y; CellY <= CellMax.Y; ++CellY)
+	{
+		for (int32 CellX = CellMin.X; CellX <= CellMax.X; ++CellX)
+		{
+			const FRandomStream CellRand(FMath::Abs(Seed + 7) ^ (CellX * 73856093) ^ (CellY * 19349663));
+
+			FVegetationCandidate& Candidate = Candidates[(CellY - CellMin.Y) * CellsX + (CellX - CellMin.X)];
+			Candidate.Position = FIntPoint(
+				CellX * VegetationCellSize + CellRand.RandRange(0, VegetationCellSize - 1),
+				CellY * VegetationCellSize + CellRand.RandRange(0, VegetationCellSize - 1));
+			Candidate.Priority = CellRand.GetFraction();
+			Candidate.Biome = GetDominantBiome(Candidate.Position.X, Candidate.Position.Y);
+
+			// Different spawn rates based on biome
+			float VegetationChance;
+			switch (Candidate.Biome)
+			{
+			case EBiomeType::Forest:
+				VegetationChance = 0.7f; // High chance in forests
+				break;
+			case EBiomeType::Plains:
+				VegetationChance = 0.2f; // Moderate chance in the plains
+				break;
+			case EBiomeType::Desert:
+				VegetationChance = 0.3f; // Reasonable chance for cacti in the desert
+				break;
+			case EBiomeType::Mountain:
+				VegetationChance = 0.08f; // Low chance in mountains
+				break;
+			case EBiomeType::Snowy:
+				VegetationChance = 0.05f; // Very low chance in snow
+				break;
+			default:
+				VegetationChance = 0.0f;
+				break;
+			}
+
+			// Apply an additional noise factor for more natural distribution
+			const float NoiseVal = FMath::Abs(Noise.GetNoise(Candidate.Position.X * 0.1f, Candidate.Position.Y * 0.1f));
+			Candidate.bWanted = CellRand.GetFraction() < VegetationChance * NoiseVal * 1.5f;
+		}
+	}
+
+	const auto IsTreeBiome = [](const EBiomeType Biome)
+	{
+		return Biome == EBiomeType::Forest || Biome == EBiomeType::Plains;
+	};
+
+	// Cells are walked in the same world order by every chunk, so overlapping canopies resolve the same way on both sides
+	for (int32 CellY = CellMin.Y + 1; CellY < CellMax.Y; ++CellY)
+	{
+		for (int32 CellX = CellMin.X + 1; CellX < CellMax.X; ++CellX)
+		{
+			const FVegetationCandidate& Candidate = Candidates[(CellY - CellMin.Y) * CellsX + (CellX - CellMin.X)];
+			if (!Candidate.bWanted) continue;
+
+			const bool bTree = IsTreeBiome(Candidate.Biome);
+			if (!bTree && Candidate.Biome != EBiomeType::Desert) continue;
+
+			// Skip structures whose bounds miss this chunk
+			const int x = Candidate.Position.X - ChunkMinX;
+			const int y = Candidate.Position.Y - ChunkMinY;
+			const int32 Reach = bTree ? TreeCanopyRadius : 0;
+			if (x + Reach < 0 || x - Reach >= ChunkSize.X || y + Reach < 0 || y - Reach >= ChunkSize.Y) continue;
+
+			// A tree yields to any wanted tree within reach that outranks it, whether or not that one gets planted,
+			// so the outcome never depends on which chunk is generated first
+			bool TooClose = false;
+			if (bTree)
+			{
+				for (int32 NeighborY = CellY - 1; NeighborY <= CellY + 1 && !TooClose; ++NeighborY)
+				{
+					for (int32 NeighborX = CellX - 1; NeighborX <= CellX + 1; ++NeighborX)
+					{
+						const FVegetationCandidate& Other = Candidates[(NeighborY - CellMin.Y) * CellsX + (NeighborX - CellMin.X)];
+						if (&Other == &Candidate || !Other.bWanted || !IsTreeBiome(Other.Biome)) continue;
+
+						if (FMath::Abs(Other.Position.X - Candidate.Position.X) + FMath::Abs(Other.Position.Y - Candidate.Position.Y) < MinTreeDistance &&
+							Other.Priority > Candidate.Priority)
+						{
+							TooClose = true;
+							break;
+						}
+					}
+				}
+			}
+			if (TooClose) continue;
+
+			// Ground comes from the world height and water from the fields around the chunk, the anchor may lie in a chunk that isn't generated
+			const int z = GetSurfaceHeight(Candidate.Position.X, Candidate.Position.Y);
+			if (z + MaxStructureHeight >= ChunkSize.Z) continue;
+			if (IsUnderWater(Columns, Candidate.Position.X, Candidate.Position.Y)) continue;
+
+			const FRandomStream VegRand(FMath::Abs(Seed + 11) ^ (Candidate.Position.X * 73856093) ^ (Candidate.Position.Y * 19349663));
+
+			if (bTree)
+			{
+				SpawnTreeAt(Data, x, y, z, VegRand);
+			}
+			else if (x >= 0 && x < ChunkSize.X && y >= 0 && y < ChunkSize.Y)
+			{
+				// A cactus never leaves its column, so it can sit on this chunk's own ground
+				int GroundZ = FMath::Min(z + 1, ChunkSize.Z - 3);
+				while (GroundZ > 0 && Data.GetBlock(Data.GetBlockIndex(x, y, GroundZ)) == EBlock::Air) --GroundZ;
+				while (Data.GetBlock(Data.GetBlockIndex(x, y, GroundZ + 1)) != EBlock::Air && GroundZ < ChunkSize.Z - 3) ++GroundZ;
+
+				if (Data.GetBlock(Data.GetBlockIndex(x, y, GroundZ)) == EBlock::Sand)
+					SpawnCactusAt(Data, x, y, GroundZ + 1);
+			}
+		}
+	}
+}
+
+bool FVoxelWorldGenerator::IsUnderWater(const FChunkColumns& Columns, const int32 WorldX, const int32 WorldY) const
+{
+	if (FMath::Abs(Columns.GetRiverNoise(WorldX, WorldY)) < RiverWidth) return true;
+
+	for (const FLake& Lake : Columns.Lakes)
+	{
+		if (IsInsideLake(Lake, WorldX, WorldY)) return true;
+	}
+	return false;
+}
+
+void FVoxelWorldGenerator::SpawnTreeAt(FChunkVoxelData& Data, int x, int y, int z, const FRandomStream& TreeRand) const
+{
+	// Test blocks in cardinal directions
+	
+	const int TrunkHeight = 4 + TreeRand.RandRange(0, 2); // 4-6 blocks tall
+	constexpr int LeafHeight = 3; // Classic Minecraft tree leaf height
+	const int LeafStartHeight = TrunkHeight - LeafHeight + 1; // Start leaves before top of trunk
+    
+	// Generate trunk, only when it stands in this chunk; x, y may lie in a neighbor that just shares the canopy
+	if (x >= 0 && x < ChunkSize.X && y >= 0 && y < ChunkSize.Y)
+	{
+		for (int i = 0; i < TrunkHeight; ++i)
+		{
+			const int tz = z + i;
+			if (tz >= ChunkSize.Z) break;
+
+			int BlockIndex = Data.GetBlockIndex(x, y, tz);
+			if (Data.GetBlock(BlockIndex) == EBlock::Air) 
+				Data.SetBlock(BlockIndex, EBlock::Log);
+		}
+
+		// z comes from the full resolution height, extend down to the chunk's own ground where it sits lower
+		for (int tz = z - 1; tz >= 0; --tz)
+		{
+			const int BlockIndex = Data.GetBlockIndex(x, y, tz);
+			if (Data.GetBlock(BlockIndex) != EBlock::Air) break;
+			Data.SetBlock(BlockIndex, EBlock::Log);
+		}
+	}
+
+
+	// Generate leaves using LeafHeight
+	for (int layer = 0; layer < LeafHeight; layer++)
+	{
+		const int lz = z + LeafStartHeight + layer;
+		if (lz >= ChunkSize.Z) continue;
+
+	
+    	
+		// Determine radius based on layer position
+		int radius;
+		if (layer == 0 || layer == LeafHeight - 1) {
+			radius = 1; // Top and bottom layers are smaller (3x3)
+		} else {
+			radius = 2; // Middle layers are larger (5x5)
+		}
+
+		
+		// Generate square of leaves for this layer
+		for (int dx = -radius; dx <= radius; dx++) {
+			for (int dy = -radius; dy <= radius; dy++)
+			{
+				int lx = x + dx;
+				int ly = y + dy;
+                
+				// Check bounds
+				if (lx < 0 || ly < 0 || lz < 0 || lx >= ChunkSize.X || ly >= ChunkSize.Y || lz >= ChunkSize.Z)
+					continue;
+                    
+				// Skip trunk position (except at the very top if trunk doesn't reach)
+				if (dx == 0 && dy == 0 && lz < z + TrunkHeight)
+					continue;
+                    
+				// Skip corners for rounder appearance on middle layers
+				if (radius == 2 && (FMath::Abs(dx) == 2 && FMath::Abs(dy) == 2))
+					continue;
+                    
+				int BlockIndex = Data.GetBlockIndex(lx, ly, lz);
+				if (Data.GetBlock(BlockIndex) == EBlock::Air)
+				{
+					Data.SetBlock(BlockIndex, EBlock::Leaves);
+				}
+			}
+		}
+    
+		// Add optional top leaf
+		int topZ = z + LeafStartHeight + LeafHeight;
+		if (topZ < ChunkSize.Z && TreeRand.FRand() < 0.5f && x >= 0 && x < ChunkSize.X && y >= 0 && y < ChunkSize.Y) {
+			int BlockIndex = Data.GetBlockIndex(x, y, topZ);
+			if (Data.GetBlock(BlockIndex) == EBlock::Air)
+				Data.SetBlock(BlockIndex, EBlock::Leaves);
+		}
+	}
+}
+
+void FVoxelWorldGenerator::SpawnCactusAt(FChunkVoxelData& Data, int x, int y, int z)
+{
+	// Spawn 2-block cactus
+	FIntVector base(x, y, z);
+	FIntVector top(x, y, z + 1);
+
+	Data.SetBlock(Data.GetBlockIndex(base.X, base.Y, base.Z), EBlock::Cactus);
+	Data.SetBlock(Data.GetBlockIndex(top.X, top.Y, top.Z), EBlock::Cactus);
+
+	// Record the original topmost block
+	Data.OriginalTopCactusBlocks.Add(top);
+}
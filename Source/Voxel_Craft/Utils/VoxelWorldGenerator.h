@@ -0,0 +1,247 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+#include "Voxel_Craft/Utils/ChunkVoxelData.h"
+#include "Voxel_Craft/Utils/Enums.h"
+#include "Voxel_Craft/Utils/FastNoiseLite.h"
+
+#include "VoxelWorldGenerator.generated.h"
+
+USTRUCT()
+struct FBiomeNoiseSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	float Frequency = 0.01f;
+
+	UPROPERTY()
+	float Amplitude = 1.0f;
+
+	UPROPERTY()
+	float Offset = 0.0f;
+
+	// Blocks between height samples, columns in between are interpolated. 1 samples every column
+	UPROPERTY()
+	int32 HeightSampleSpacing = 1;
+};
+
+/**
+ * FVoxelWorldGenerator
+ * Terrain generator for a whole world: the configured noise stacks and biome tables. Built
+ * once by the chunk world and shared by every chunk and generation job. It is never modified
+ * after construction and touches no actors or UObjects, so any number of worker threads can
+ * generate chunks from the same instance at once.
+ */
+class FVoxelWorldGenerator
+{
+public:
+	/**
+	 * @param bInCoarseHeights Sample biome heights on each biome's HeightSampleSpacing lattice and interpolate
+	 *        the columns in between, otherwise every column is sampled
+	 * @param InDensitySampleSpacing Blocks between 3D density samples, 1 samples every voxel
+	 */
+	FVoxelWorldGenerator(int32 InSeed, float InFrequency, const FIntVector& InChunkSize, bool bInCoarseHeights = true, int32 InDensitySampleSpacing = 4);
+
+	/**
+	 * Generate voxels for the chunk whose origin is at Position
+	 * @param Data Buffer to fill, resized to the chunk size
+	 * @param Position Chunk origin in blocks
+	 * @param GenerationType 2D height map or 3D density terrain
+	 * @param Stages 2D stages to run, e.g. without decoration for far chunks
+	 */
+	void Generate(FChunkVoxelData& Data, const FVector& Position, EGenerationType GenerationType,
+	              EGenerationStage Stages = EGenerationStage::All) const;
+
+	// Average time a generated chunk spent in Stage so far, across all threads. 3D generation counts as the fill
+	double GetStageMsPerChunk(EGenerationStage Stage) const;
+
+	int32 GetGeneratedChunkCount() const { return static_cast<int32>(GeneratedChunkCount.load(std::memory_order_relaxed)); }
+
+	// Base terrain noise, for chunk types that build their own voxels from it
+	const FastNoiseLite& GetTerrainNoise() const { return Noise; }
+
+	/**
+	 * 3D terrain density, negative is solid. Noise is sampled every DensitySampleSpacing blocks on a
+	 * lattice shared by all chunks and trilinearly interpolated in between
+	 * @param Origin First point in blocks
+	 * @param Count Points along each axis, Out is indexed (z * Count.Y + y) * Count.X + x
+	 */
+	void GetDensityGrid(const FVector& Origin, const FIntVector& Count, TArray<float>& Out) const;
+
+private:
+	int32 Seed;
+	FIntVector ChunkSize;
+	bool bCoarseHeights;
+	int32 DensitySampleSpacing;
+
+	FastNoiseLite Noise;
+	FastNoiseLite BiomeNoise;
+	FastNoiseLite RiverNoise;
+	FastNoiseLite LakeNoise;
+
+	TMap<EBiomeType, FBiomeNoiseSettings> BiomeSettingsMap;
+
+	static constexpr int32 NumGenerationStages = 5;
+
+	// Cycles spent per stage and chunks generated, summed over every thread
+	mutable std::atomic<uint64> StageCycles[NumGenerationStages] = {};
+	mutable std::atomic<uint32> GeneratedChunkCount = 0;
+
+	static int32 GetStageIndex(EGenerationStage Stage) { return static_cast<int32>(FMath::CountTrailingZeros(static_cast<uint32>(Stage))); }
+
+	// Adds the time spent in its scope to the stage's total
+	struct FStageTimer
+	{
+		FStageTimer(const FVoxelWorldGenerator& Generator, EGenerationStage Stage);
+		~FStageTimer();
+
+		std::atomic<uint64>& TotalCycles;
+		uint64 StartCycles;
+	};
+
+	// Block runs of one column: stone, MidBlock from MidStart, TopBlock from TopStart up to Height, air above
+	struct FColumnRuns
+	{
+		int32 Height;
+		int32 MidStart;
+		int32 TopStart;
+		EBlock MidBlock;
+		EBlock TopBlock;
+	};
+
+	// A lake placed by GetLakes, WaterLevel is taken at its center
+	struct FLake
+	{
+		int32 CenterX;
+		int32 CenterY;
+		int32 Radius;
+		int32 WaterLevel;
+	};
+
+	// What the height stage works out for a 2D chunk, read by every later stage
+	struct FChunkColumns
+	{
+		int32 ChunkMinX;
+		int32 ChunkMinY;
+
+		// Indexed y * ChunkSize.X + x, like a Z layer of the chunk
+		TArray<FColumnRuns> Runs;
+
+		// Lowest layer any column leaves stone at, and the highest surface
+		int32 LowestRun;
+		int32 HighestSurface;
+
+		// Lakes reaching the chunk or structures anchored just outside it
+		TArray<FLake> Lakes;
+
+		// River noise of the chunk's columns and MaxStructureReach columns past it on every side, read through
+		// GetRiverNoise so carving and decoration see the same river
+		TArray<float> RiverField;
+		int32 RiverFieldWidth;
+
+		float GetRiverNoise(int32 WorldX, int32 WorldY) const
+		{
+			return RiverField[(WorldY - ChunkMinY + MaxStructureReach) * RiverFieldWidth + (WorldX - ChunkMinX + MaxStructureReach)];
+		}
+	};
+
+	void Generate2D(FChunkVoxelData& Data, const FVector& Position, EGenerationStage Stages) const;
+	void Generate3D(FChunkVoxelData& Data, const FVector& Position) const;
+
+	// 2D stages in pipeline order: heights and biomes, terrain fill, lakes, rivers, then PlaceStructures
+	void ComputeColumns(const FVector& Position, FChunkColumns& Out) const;
+	void FillColumns(FChunkVoxelData& Data, const FChunkColumns& Columns) const;
+	void PlaceLakes(FChunkVoxelData& Data, const FChunkColumns& Columns) const;
+	void CarveRivers(FChunkVoxelData& Data, const FChunkColumns& Columns) const;
+
+	// Columns sampled by a noise grid: CountX by CountY points Spacing blocks apart, starting at world column X, Y
+	struct FColumnLattice
+	{
+		float X;
+		float Y;
+		int32 Spacing;
+		int32 CountX;
+		int32 CountY;
+
+		int32 Num() const { return CountX * CountY; }
+	};
+
+	// The lattice of every Spacing-th world column that covers the chunk at X, Y, Spacing 1 is the chunk's own columns
+	FColumnLattice GetChunkLattice(float X, float Y, int32 Spacing) const;
+
+	// Samples the chunk's ChunkSize.X by ChunkSize.Y column lattice starting at X, Y into Out, indexed y * ChunkSize.X + x
+	void GetNoiseGrid2D(const FastNoiseLite& InNoise, float X, float Y, float Scale, TArray<float>& Out) const;
+	void GetNoiseGrid2D(const FastNoiseLite& InNoise, const FColumnLattice& Lattice, float Scale, TArray<float>& Out) const;
+
+	// Bilinearly fills the chunk's columns at X, Y from values sampled on Lattice
+	void InterpolateGrid2D(const FColumnLattice& Lattice, const TArray<float>& Samples, float X, float Y, TArray<float>& Out) const;
+
+	/**
+	 * Octaves of InNoise summed over the column lattice, each at twice the frequency and Persistence times the amplitude.
+	 * Octave grids are looked up in OctaveGrids by frequency and only sampled when missing, so biomes whose octave
+	 * frequencies line up (0.005, 0.01, 0.02 ... are each other's doubles) share them within a chunk.
+	 */
+	void GetFractalNoiseGrid2D(const FastNoiseLite& InNoise, const FColumnLattice& Lattice, float Frequency, int Octaves, float Persistence,
+	                           TMap<float, TArray<float>>& OctaveGrids, TArray<float>& Out) const;
+
+	// Biome weight falloff Pow(t, 2.5) tabulated over t in [0, 1], sampled with linear interpolation
+	static constexpr int32 InfluenceCurveResolution = 256;
+	TArray<float> InfluenceCurve;
+
+	float GetBiomeInfluence(float Falloff) const;
+
+	// Surface height and dominant biome of a column from each biome's influence and height noise, both indexed like BiomeRanges
+	int32 BlendColumnHeight(const float* Influences, const float* HeightNoise, float Detail, EBiomeType& OutDominantBiome) const;
+
+	// A biome's fractal height noise at a single world column, interpolated from the same lattice ComputeColumns samples
+	float GetBiomeHeightNoise(const FBiomeNoiseSettings& Settings, float WorldX, float WorldY) const;
+
+	// Surface height of a single world column, the height the fill gives it, for stages that reach past the chunk such as
+	// lakes centered in a neighbor and structures anchored in one
+	int32 GetSurfaceHeight(float WorldX, float WorldY) const;
+
+	// Biome with the most influence on a single world column, Plains where none reaches
+	EBiomeType GetDominantBiome(float WorldX, float WorldY) const;
+
+	// One candidate lake per LakeCellSize cell of the world, so lakes don't depend on which chunk asks
+	static constexpr int32 LakeCellSize = 32;
+	static constexpr float LakeChance = 0.5f;
+	static constexpr int32 MaxLakeRadius = 14;
+	static constexpr float LakeRimNoise = 3.0f; // Shore wobble in blocks either way
+	static constexpr int32 MaxLakeReach = MaxLakeRadius + 3;
+
+	// Lakes whose footprint may reach the world columns MinX..MaxX, MinY..MaxY, in a fixed order
+	void GetLakes(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY, TArray<FLake>& Out) const;
+
+	// Whether a world column lies inside the lake's noisy shore
+	bool IsInsideLake(const FLake& Lake, int32 WorldX, int32 WorldY) const;
+
+	static constexpr float RiverWidth = 0.07f;
+	static constexpr float RiverNoiseScale = 0.3f; // Folded into the river noise frequency, it is sampled at whole columns
+
+	// Whether a world column within MaxStructureReach of the chunk is taken by a river or one of its lakes
+	bool IsUnderWater(const FChunkColumns& Columns, int32 WorldX, int32 WorldY) const;
+
+	// Vegetation candidates, one per cell of the world, trunks kept MinTreeDistance apart (Manhattan)
+	static constexpr int32 VegetationCellSize = 4;
+	static constexpr int32 MinTreeDistance = 5;
+
+	// Structure extent around and above its anchor column
+	static constexpr int32 TreeCanopyRadius = 2;
+	static constexpr int32 MaxStructureReach = TreeCanopyRadius;
+	static constexpr int32 MaxStructureHeight = 7;
+
+	/**
+	 * Decoration stage: writes every tree and cactus whose bounds intersect the chunk, including those anchored in
+	 * neighbors, clipped to the chunk. Structures stay out of the lakes and rivers in Columns
+	 */
+	void PlaceStructures(FChunkVoxelData& Data, const FChunkColumns& Columns) const;
+
+	// x, y are chunk local and may lie outside the chunk, only the part inside is written
+	void SpawnTreeAt(FChunkVoxelData& Data, int x, int y, int z, const FRandomStream& TreeRand) const;
+	static void SpawnCactusAt(FChunkVoxelData& Data, int x, int y, int z);
+};
@@ -0,0 +1,88 @@
+#include "ChunkRegistry.h"
+
+void FChunkRegistry::Init(const FIntVector& InGridSize)
+{
+	check(InGridSize.X > 0 && InGridSize.Y > 0 && InGridSize.Z > 0);
+
+	GridSize = InGridSize;
+	Slots.Reset();
+	Slots.SetNum(GridSize.X * GridSize.Y * GridSize.Z);
+	Count = 0;
+}
+
+void FChunkRegistry::Empty()
+{
+	for (FSlot& Slot : Slots)
+	{
+		Slot = FSlot();
+	}
+	Count = 0;
+}
+
+bool FChunkRegistry::Add(const FIntVector& Coord, AGreedyChunk* Chunk)
+{
+	FSlot* Slot = ClaimSlot(Coord);
+	if (!Slot) return false;
+
+	Slot->Chunk = Chunk;
+	Slot->ElidedBlock = EBlock::Null;
+	return true;
+}
+
+bool FChunkRegistry::AddElided(const FIntVector& Coord, const EBlock Block)
+{
+	check(Block != EBlock::Null);
+
+	FSlot* Slot = ClaimSlot(Coord);
+	if (!Slot) return false;
+
+	Slot->Chunk = nullptr;
+	Slot->ElidedBlock = Block;
+	return true;
+}
+
+FChunkRegistry::FSlot* FChunkRegistry::ClaimSlot(const FIntVector& Coord)
+{
+	if (Slots.IsEmpty()) return nullptr;
+
+	FSlot& Slot = Slots[GetSlotIndex(Coord)];
+
+	if (Slot.IsUsed() && Slot.Coord != Coord)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Chunk registry slot for %s is still held by %s"), *Coord.ToString(), *Slot.Coord.ToString());
+		return nullptr;
+	}
+
+	if (!Slot.IsUsed()) ++Count;
+
+	Slot.Coord = Coord;
+	return &Slot;
+}
+
+void FChunkRegistry::Remove(const FIntVector& Coord)
+{
+	if (Slots.IsEmpty()) return;
+
+	FSlot& Slot = Slots[GetSlotIndex(Coord)];
+
+	if (Slot.IsUsed() && Slot.Coord == Coord)
+	{
+		Slot = FSlot();
+		--Count;
+	}
+}
+
+TArray<FIntVector> FChunkRegistry::GetLoadedCoords() const
+{
+	TArray<FIntVector> Coords;
+	Coords.Reserve(Count);
+
+	for (const FSlot& Slot : Slots)
+	{
+		if (Slot.IsUsed())
+		{
+			Coords.Add(Slot.Coord);
+		}
+	}
+	return Coords;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Voxel_Craft/Utils/Enums.h"
+
+class AGreedyChunk;
+
+/**
+ * FChunkRegistry
+ * Loaded greedy chunks of one world, stored in a fixed size toroidal grid: a chunk lives in
+ * the slot at its coordinate modulo the grid size. Streaming keeps every loaded chunk within
+ * one grid size of each other, so each gets its own slot and lookups are a couple of
+ * modulos and a compare. A chunk filled with a single block (open air, buried rock) can be
+ * recorded without an actor, so it still counts as loaded but costs nothing to keep.
+ */
+class FChunkRegistry
+{
+public:
+	// Sizes the grid to hold GridSize chunks along each axis and empties it
+	void Init(const FIntVector& InGridSize);
+
+	void Empty();
+
+	// Registers a chunk, fails if its slot is still held by a chunk at another coordinate
+	bool Add(const FIntVector& Coord, AGreedyChunk* Chunk);
+
+	// Registers a chunk filled with Block that has no actor, same failure as Add
+	bool AddElided(const FIntVector& Coord, EBlock Block);
+
+	void Remove(const FIntVector& Coord);
+
+	// True when Add would succeed, false while the slot still holds a chunk waiting to be unloaded
+	bool CanAdd(const FIntVector& Coord) const;
+
+	// The chunk actor at Coord, nullptr when nothing is loaded there or the chunk was elided
+	AGreedyChunk* Find(const FIntVector& Coord) const;
+
+	// The block filling an elided chunk, Null when Coord isn't an elided chunk
+	EBlock GetElidedBlock(const FIntVector& Coord) const;
+
+	// True for chunk actors and elided chunks alike
+	bool Contains(const FIntVector& Coord) const;
+
+	int32 Num() const { return Count; }
+
+	TArray<FIntVector> GetLoadedCoords() const;
+
+private:
+	struct FSlot
+	{
+		FIntVector Coord = FIntVector::ZeroValue;
+		AGreedyChunk* Chunk = nullptr;
+
+		// Set instead of Chunk for elided chunks
+		EBlock ElidedBlock = EBlock::Null;
+
+		bool IsUsed() const { return Chunk || ElidedBlock != EBlock::Null; }
+	};
+
+	FIntVector GridSize = FIntVector::ZeroValue;
+
+	TArray<FSlot> Slots;
+
+	int32 Count = 0;
+
+	int32 GetSlotIndex(const FIntVector& Coord) const;
+
+	// The used slot holding Coord, nullptr when there is none
+	const FSlot* FindSlot(const FIntVector& Coord) const;
+
+	// The slot for Coord, marked used and counted, nullptr when another coordinate holds it
+	FSlot* ClaimSlot(const FIntVector& Coord);
+};
+
+inline int32 FChunkRegistry::GetSlotIndex(const FIntVector& Coord) const
+{
+	// Positive modulo, negative coordinates wrap to the far end of the grid
+	const auto Wrap = [](const int32 Value, const int32 Size)
+	{
+		const int32 Remainder = Value % Size;
+		return Remainder < 0 ? Remainder + Size : Remainder;
+	};
+
+	return (Wrap(Coord.Z, GridSize.Z) * GridSize.Y + Wrap(Coord.Y, GridSize.Y)) * GridSize.X + Wrap(Coord.X, GridSize.X);
+}
+
+inline const FChunkRegistry::FSlot* FChunkRegistry::FindSlot(const FIntVector& Coord) const
+{
+	if (Slots.IsEmpty()) return nullptr;
+
+	const FSlot& Slot = Slots[GetSlotIndex(Coord)];
+	return Slot.IsUsed() && Slot.Coord == Coord ? &Slot : nullptr;
+}
+
+inline AGreedyChunk* FChunkRegistry::Find(const FIntVector& Coord) const
+{
+	const FSlot* Slot = FindSlot(Coord);
+	return Slot ? Slot->Chunk : nullptr;
+}
+
+inline EBlock FChunkRegistry::GetElidedBlock(const FIntVector& Coord) const
+{
+	const FSlot* Slot = FindSlot(Coord);
+	return Slot ? Slot->ElidedBlock : EBlock::Null;
+}
+
+inline bool FChunkRegistry::CanAdd(const FIntVector& Coord) const
+{
+	if (Slots.IsEmpty()) return false;
+
+	const FSlot& Slot = Slots[GetSlotIndex(Coord)];
+	return !Slot.IsUsed() || Slot.Coord == Coord;
+}
+
+inline bool FChunkRegistry::Contains(const FIntVector& Coord) const
+{
+	return FindSlot(Coord) != nullptr;
+}
@@ -5,8 +5,24 @@
 #include "Voxel_craft/Chunks/ChunkBase.h"
 #include "Voxel_craft/Utils/WaterSimulator.h"
 #include "Voxel_craft/Chunks/GreedyChunk.h"
+#include "Voxel_Craft/Utils/VoxelWorldGenerator.h"
 #include "Kismet/GameplayStatics.h"
 
+namespace
+{
+	const FIntVector FaceOffsets[] = {
+		FIntVector(-1, 0, 0), FIntVector(1, 0, 0),
+		FIntVector(0, -1, 0), FIntVector(0, 1, 0),
+		FIntVector(0, 0, -1), FIntVector(0, 0, 1)
+	};
+
+	// Blocks that hide whatever is behind them, so a chunk filled with one has no visible faces of its own
+	bool IsOpaqueBlock(const EBlock Block)
+	{
+		return Block != EBlock::Null && Block != EBlock::Air && Block != EBlock::Water;
+	}
+}
+
 // Sets default values
 AChunkWorld::AChunkWorld()
 {
@@ -25,6 +41,18 @@ void AChunkWorld::BeginPlay()
 	{
 		GetWorldTimerManager().SetTimer(UpdateTimerHandle, this, &AChunkWorld::UpdateChunks, 0.5f, true);
 	}
+
+	// 3D worlds stack small cubes instead of full height columns
+	if (GenerationType == EGenerationType::GT_3D)
+	{
+		ChunkSize = FIntVector(CubicChunkSize);
+	}
+
+	WorldGenerator = MakeShared<FVoxelWorldGenerator>(Seed, Frequency, ChunkSize, bCoarseHeightSampling, DensitySampleSpacing);
+
+	// Every loaded chunk stays inside the streaming box, so one slot per chunk in it is enough
+	ChunkRegistry.Init(GetStreamingRadius() * 2 + FIntVector(1, 1, 1));
+
 	WaterSimulator = new FWaterSimulator(ChunkSize); // ✅ create simulator
 
 	WaterSimulator->SetChunkFetcher([this](const FIntVector& Position) -> AGreedyChunk*
@@ -35,115 +63,56 @@ void AChunkWorld::BeginPlay()
 		int32 ChunkZ = FMath::FloorToInt(static_cast<float>(Position.Z / (ChunkSize.Z * 100)));
 		FIntVector ChunkCoords(ChunkX, ChunkY, (GenerationType == EGenerationType::GT_3D) ? ChunkZ : 0);
 
-		bool bFound = AGreedyChunk::LoadedChunks.Contains(ChunkCoords);
-		
-		
-		return bFound ? AGreedyChunk::LoadedChunks[ChunkCoords] : nullptr;
+		return ChunkRegistry.Find(ChunkCoords);
 	});
 	
-	switch (GenerationType)
-	{
-	case EGenerationType::GT_3D:
-		Generate3DWorld();
-		break;
-	case EGenerationType::GT_2D:
-		Generate2DWorld();
-		break;
-	default:
-		throw std::invalid_argument("Invalid Generation Type");
-	}
-	TArray<FIntVector> AllCoords;
-	for (const auto& Pair : AGreedyChunk::LoadedChunks)
-	{
-		AllCoords.Add(Pair.Key);
-	}
-	FixMeshesWhereNeighborsExist(AllCoords);
+	GenerateWorld();
+
+	// The initial world covers the streaming range around the origin
+	StreamingCenter = FIntVector::ZeroValue;
+
+	FixMeshesWhereNeighborsExist(ChunkRegistry.GetLoadedCoords());
 	UE_LOG(LogTemp, Warning, TEXT("%d Chunks Created"), ChunkCount);
+	LogGenerationTimings();
 }
 
-void AChunkWorld::Generate3DWorld()
+void AChunkWorld::GenerateWorld()
 {
-		if (!ChunkType)
-		{
-			UE_LOG(LogTemp, Error, TEXT("ChunkType is not set!"));
-			return;  // Early exit if ChunkType is not set
-		}
-	for (int x = -DrawDistance; x <= DrawDistance; x++)
+	if (!ChunkType)
 	{
-		for (int y = -DrawDistance; y <= DrawDistance; ++y)
-		{
-			for (int z = -DrawDistance; z <= DrawDistance; ++z)
-			{
-				
-				auto transform = FTransform(
-					FRotator::ZeroRotator,
-					FVector(x * ChunkSize.X * 100, y * ChunkSize.Y * 100, z * ChunkSize.Z * 100),
-					FVector::OneVector
-				);
+		UE_LOG(LogTemp, Error, TEXT("ChunkType is not set!"));
+		return;
+	}
 
-				const auto chunk = GetWorld()->SpawnActorDeferred<AChunkBase>(
-					ChunkType,
-					transform,
-					this
-				);
+	const FIntVector Radius = GetStreamingRadius();
 
-				chunk->GenerationType = EGenerationType::GT_3D;
-				chunk->Frequency = Frequency;
-				chunk->Materials = Materials;
-				chunk->ChunkSize = ChunkSize;
+	// Chunk types that build their own voxels are spawned straight away
+	if (!ChunkType->IsChildOf(AGreedyChunk::StaticClass()))
+	{
+		ForEachCoordInBox(-Radius, Radius, [this](const FIntVector& Coord)
+		{
+			SpawnChunkAt(Coord, FChunkVoxelData());
+		});
+		return;
+	}
 
-				chunk->SetSeed(Seed);
+	// STEP 1: Generate all voxels in parallel on worker threads
+	TArray<FIntVector> Coords;
+	TArray<UE::Tasks::TTask<FChunkVoxelData>> Tasks;
+	ForEachCoordInBox(-Radius, Radius, [this, &Coords, &Tasks](const FIntVector& Coord)
+	{
+		if (ChunkRegistry.Contains(Coord)) return;
 
-				UGameplayStatics::FinishSpawningActor(chunk, transform);
+		Coords.Add(Coord);
+		Tasks.Add(LaunchGenerationTask(Coord));
+	});
 
-				ChunkCount++;
-			}
-		}
-	}
-}
+	UE::Tasks::Wait(Tasks);
 
-void AChunkWorld::Generate2DWorld()
-{
-	// STEP 1: Spawn all chunks (no mesh yet)
-	for (int x = -DrawDistance; x <= DrawDistance; x++)
+	// STEP 2: Spawn all chunks (no mesh yet)
+	for (int32 i = 0; i < Coords.Num(); ++i)
 	{
-		for (int y = -DrawDistance; y <= DrawDistance; ++y)
-		{
-			FIntVector Coord(x, y, 0);
-			if (AGreedyChunk::LoadedChunks.Contains(Coord))
-				continue;
-
-			FTransform Transform(
-				FRotator::ZeroRotator,
-				FVector(x * ChunkSize.X * 100, y * ChunkSize.Y * 100, 0),
-				FVector::OneVector
-			);
-
-			AGreedyChunk* Chunk = GetWorld()->SpawnActorDeferred<AGreedyChunk>(
-				ChunkType,
-				Transform,
-				this
-			);
-
-			Chunk->ChunkSize = ChunkSize;
-			Chunk->Frequency = Frequency;
-			Chunk->Materials = Materials;
-			Chunk->SetSeed(Seed);
-			Chunk->GenerationType = EGenerationType::GT_2D;
-
-			Chunk->bShouldGenerateInitialMesh = false;
-
-			
-			if (!WaterSimulator)
-			{
-				Chunk->SetWaterSimulator(WaterSimulator);
-			}
-			Chunk->InitializeChunkOrigin(Coord);
-
-			UGameplayStatics::FinishSpawningActor(Chunk, Transform);
-			AGreedyChunk::LoadedChunks.Add(Coord, Chunk);
-			ChunkCount++;
-		}
+		AddGeneratedChunk(Coords[i], MoveTemp(Tasks[i].GetResult()));
 	}
 }
 FIntVector AChunkWorld::WorldToChunkCoord(const FVector& Location) const
@@ -156,21 +125,127 @@ FIntVector AChunkWorld::WorldToChunkCoord(const FVector& Location) const
 			: 0
 	);
 }
-void AChunkWorld::SpawnChunkAt(const FIntVector& Coord)
+void AChunkWorld::QueueChunkGeneration(const FIntVector& Coord)
 {
-	
-	UE_LOG(LogTemp, Warning, TEXT("SpawnChunkAt called for Coord X=%d Y=%d Z=%d"), Coord.X, Coord.Y, Coord.Z);
-
 	if (!ChunkType)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("ChunkType is null!"));
 		return;
 	}
 
-	if (AGreedyChunk::LoadedChunks.Contains(Coord))
+	if (ChunkRegistry.Contains(Coord) || PendingGeneration.Contains(Coord))
+	{
+		return; // Already spawned or being generated
+	}
+
+	// Only greedy chunks take pre-generated voxels, other chunk types still generate in BeginPlay
+	if (!ChunkType->IsChildOf(AGreedyChunk::StaticClass()))
+	{
+		SpawnChunkAt(Coord, FChunkVoxelData());
+		return;
+	}
+
+	PendingGeneration.Add(Coord, LaunchGenerationTask(Coord));
+}
+
+UE::Tasks::TTask<FChunkVoxelData> AChunkWorld::LaunchGenerationTask(const FIntVector& Coord) const
+{
+	// The job holds its own reference to the generator, it must not touch this actor from the worker thread
+	const FVector Position(Coord.X * ChunkSize.X, Coord.Y * ChunkSize.Y, Coord.Z * ChunkSize.Z);
+
+	const EGenerationStage Stages = static_cast<EGenerationStage>(GenerationStages);
+
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Generator = WorldGenerator, Position, Type = GenerationType, Stages]
+	{
+		FChunkVoxelData Voxels;
+		Generator->Generate(Voxels, Position, Type, Stages);
+		return Voxels;
+	});
+}
+
+void AChunkWorld::LogGenerationTimings() const
+{
+	if (!WorldGenerator || WorldGenerator->GetGeneratedChunkCount() == 0) return;
+
+	UE_LOG(LogTemp, Log, TEXT("Generation ms/chunk over %d chunks: height %.3f, fill %.3f, water bodies %.3f, carving %.3f, decoration %.3f"),
+		WorldGenerator->GetGeneratedChunkCount(),
+		WorldGenerator->GetStageMsPerChunk(EGenerationStage::Height),
+		WorldGenerator->GetStageMsPerChunk(EGenerationStage::Fill),
+		WorldGenerator->GetStageMsPerChunk(EGenerationStage::WaterBodies),
+		WorldGenerator->GetStageMsPerChunk(EGenerationStage::Carving),
+		WorldGenerator->GetStageMsPerChunk(EGenerationStage::Decoration));
+}
+
+float AChunkWorld::GetLoadPriority(const FIntVector& Coord, const FVector& ViewLocation, const FVector& ViewDirection) const
+{
+	const FVector ChunkSizeUnits = FVector(ChunkSize) * 100.0f;
+	FVector ToChunk = (FVector(Coord) + FVector(0.5f)) * ChunkSizeUnits - ViewLocation;
+
+	// Columns span the whole height in 2D, only the horizontal offset matters
+	if (GenerationType == EGenerationType::GT_2D)
+	{
+		ToChunk.Z = 0.0f;
+	}
+
+	const float Distance = ToChunk.Size() / ChunkSizeUnits.X;
+	const float Facing = FVector::DotProduct(ToChunk.GetSafeNormal(), ViewDirection);
+
+	// Straight ahead keeps its distance, straight behind counts twice as far
+	return Distance * (1.5f - 0.5f * Facing);
+}
+
+void AChunkWorld::ProcessLoadQueue(const double Deadline)
+{
+	while (LoadQueue.Num() > 0 && PendingGeneration.Num() < MaxConcurrentGenerationJobs && FPlatformTime::Seconds() < Deadline)
+	{
+		FChunkLoadRequest Request;
+		LoadQueue.HeapPop(Request, EAllowShrinking::No);
+		QueueChunkGeneration(Request.Coord);
+	}
+}
+
+void AChunkWorld::SpawnGeneratedChunks(const double Deadline)
+{
+	for (auto It = PendingGeneration.CreateIterator(); It; ++It)
+	{
+		if (FPlatformTime::Seconds() >= Deadline) break;
+		if (!It->Value.IsCompleted()) continue;
+
+		// Its registry slot frees up once the chunk that left range there is unloaded
+		const FIntVector Coord = It->Key;
+		if (!ChunkRegistry.CanAdd(Coord)) continue;
+
+		FChunkVoxelData Voxels = MoveTemp(It->Value.GetResult());
+		It.RemoveCurrent();
+
+		AddGeneratedChunk(Coord, MoveTemp(Voxels));
+		FixMeshesWhereNeighborsExist(GetChunkAndNeighbors(Coord));
+	}
+}
+
+AChunkBase* AChunkWorld::SpawnChunkAt(const FIntVector& Coord, FChunkVoxelData&& Voxels)
+{
+	if (ChunkRegistry.Contains(Coord))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Chunk already loaded at Coord X=%d Y=%d Z=%d"), Coord.X, Coord.Y, Coord.Z);
-		return; // Do nothing if the chunk is already spawned
+		return nullptr; // Do nothing if the chunk is already spawned
+	}
+
+	// Recycle an unloaded chunk instead of spawning a new actor
+	if (!ChunkPool.IsEmpty())
+	{
+		AGreedyChunk* Pooled = ChunkPool.Pop(EAllowShrinking::No);
+
+		// Its registry slot is still held by another chunk, leave the actor parked
+		if (!ChunkRegistry.Add(Coord, Pooled))
+		{
+			ChunkPool.Add(Pooled);
+			return nullptr;
+		}
+
+		Pooled->ReuseAt(Coord, MoveTemp(Voxels));
+		Pooled->LinkNeighbors();
+		return Pooled;
 	}
 	
 	FVector SpawnLocation = FVector(Coord.X, Coord.Y, Coord.Z) * FVector(ChunkSize.X, ChunkSize.Y, ChunkSize.Z) * 100.0f;
@@ -181,23 +256,28 @@ void AChunkWorld::SpawnChunkAt(const FIntVector& Coord)
 	if (AGreedyChunk* GreedyChunk = Cast<AGreedyChunk>(Chunk))
 	{
 
-		GreedyChunk->GenerationType = EGenerationType::GT_2D;
+		GreedyChunk->GenerationType = GenerationType;
 		GreedyChunk->Frequency = Frequency;
 		GreedyChunk->Materials = Materials;
 		GreedyChunk->ChunkSize = ChunkSize;
 		GreedyChunk->SetSeed(Seed);
+		GreedyChunk->SetWorldGenerator(WorldGenerator);
         GreedyChunk->bShouldGenerateInitialMesh = false; // Add this
+		GreedyChunk->MeshingAlgorithm = MeshingAlgorithm;
 
+		GreedyChunk->SetChunkRegistry(&ChunkRegistry);
+		GreedyChunk->SetVoxelData(MoveTemp(Voxels));
 		GreedyChunk->InitializeChunkOrigin(Coord);
 	}
 	else
 	{
 		// For any other Chunk type, set only the base properties
-		Chunk->GenerationType = EGenerationType::GT_2D;
+		Chunk->GenerationType = GenerationType;
 		Chunk->Frequency = Frequency;
 		Chunk->Materials = Materials;
 		Chunk->ChunkSize = ChunkSize;
 		Chunk->SetSeed(Seed);
+		Chunk->SetWorldGenerator(WorldGenerator);
 	}
 	
 	UGameplayStatics::FinishSpawningActor(Chunk, Transform);
@@ -205,67 +285,250 @@ void AChunkWorld::SpawnChunkAt(const FIntVector& Coord)
 	if (AGreedyChunk* Greedy = Cast<AGreedyChunk>(Chunk))
 	{
 		Greedy->SetWaterSimulator(WaterSimulator);
-		AGreedyChunk::LoadedChunks.Add(Coord, Greedy);
 
+		// An unregistered chunk would never be unloaded or linked, so don't keep it around
+		if (!ChunkRegistry.Add(Coord, Greedy))
+		{
+			ReleaseChunk(Greedy);
+			return nullptr;
+		}
+		Greedy->LinkNeighbors();
+
+	}
+	ChunkCount++;
+
+	return Chunk;
+}
+
+void AChunkWorld::AddGeneratedChunk(const FIntVector& Coord, FChunkVoxelData&& Voxels)
+{
+	// Only cubic chunks are elided, a 2D column always holds both ground and sky
+	const EBlock UniformBlock = GenerationType == EGenerationType::GT_3D ? Voxels.GetUniformBlock() : EBlock::Null;
+
+	// Open air has no faces, and rock with only solid chunks around it has none anyone can see
+	if (UniformBlock == EBlock::Air || (IsOpaqueBlock(UniformBlock) && !HasOpenNeighbor(Coord)))
+	{
+		if (!ChunkRegistry.AddElided(Coord, UniformBlock)) return;
+	}
+	else
+	{
+		SpawnChunkAt(Coord, MoveTemp(Voxels));
+	}
+
+	if (!IsOpaqueBlock(UniformBlock))
+	{
+		SpawnExposedNeighbors(Coord);
+	}
+}
+
+bool AChunkWorld::HasOpenNeighbor(const FIntVector& Coord) const
+{
+	for (const FIntVector& Offset : FaceOffsets)
+	{
+		const FIntVector NeighborCoord = Coord + Offset;
+
+		if (const AGreedyChunk* Neighbor = ChunkRegistry.Find(NeighborCoord))
+		{
+			if (!IsOpaqueBlock(Neighbor->GetUniformBlock())) return true;
+		}
+		else if (ChunkRegistry.Contains(NeighborCoord) && !IsOpaqueBlock(ChunkRegistry.GetElidedBlock(NeighborCoord)))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void AChunkWorld::SpawnExposedNeighbors(const FIntVector& Coord)
+{
+	for (const FIntVector& Offset : FaceOffsets)
+	{
+		const FIntVector NeighborCoord = Coord + Offset;
+		const EBlock Block = ChunkRegistry.GetElidedBlock(NeighborCoord);
+		if (!IsOpaqueBlock(Block)) continue;
+
+		FChunkVoxelData Filled;
+		Filled.Init(ChunkSize, Block);
+
+		ChunkRegistry.Remove(NeighborCoord);
+		SpawnChunkAt(NeighborCoord, MoveTemp(Filled));
+	}
+}
+
+TArray<FIntVector> AChunkWorld::GetChunkAndNeighbors(const FIntVector& Coord) const
+{
+	TArray<FIntVector> Coords = {Coord, Coord + FIntVector(1,0,0), Coord + FIntVector(-1,0,0), Coord + FIntVector(0,1,0), Coord + FIntVector(0,-1,0)};
+	if (GenerationType == EGenerationType::GT_3D)
+	{
+		Coords.Add(Coord + FIntVector(0, 0, 1));
+		Coords.Add(Coord + FIntVector(0, 0, -1));
 	}
-	FixMeshesWhereNeighborsExist({Coord, Coord + FIntVector(1,0,0), Coord + FIntVector(-1,0,0), Coord + FIntVector(0,1,0), Coord + FIntVector(0,-1,0)});
+	return Coords;
 }
 void AChunkWorld::RemoveChunkAt(const FIntVector& Coord)
 {
-	if (AChunkBase* Chunk = AGreedyChunk::LoadedChunks.FindRef(Coord))
+	// Drop the job if the chunk left range before it finished, the result is simply discarded
+	PendingGeneration.Remove(Coord);
+	PendingMeshes.Remove(Coord);
+
+	// Elided chunks only have their registry entry to drop
+	AGreedyChunk* Chunk = ChunkRegistry.Find(Coord);
+	ChunkRegistry.Remove(Coord);
+
+	if (Chunk)
+	{
+		Chunk->UnlinkNeighbors();
+		ReleaseChunk(Chunk);
+	}
+	FixMeshesWhereNeighborsExist(GetChunkAndNeighbors(Coord));
+}
+
+void AChunkWorld::ReleaseChunk(AGreedyChunk* Chunk)
+{
+	if (ChunkPool.Num() < MaxPooledChunks)
+	{
+		Chunk->ReturnToPool();
+		ChunkPool.Add(Chunk);
+	}
+	else
 	{
 		Chunk->Destroy();
-		AGreedyChunk::LoadedChunks.Remove(Coord);  // <--- Remove from map here!
 	}
-	FixMeshesWhereNeighborsExist({Coord, Coord + FIntVector(1,0,0), Coord + FIntVector(-1,0,0), Coord + FIntVector(0,1,0), Coord + FIntVector(0,-1,0)});
 }
 void AChunkWorld::UpdateChunks()
 {
 	if (!PlayerPawn) return;
 
-	FIntVector CenterCoord = WorldToChunkCoord(PlayerPawn->GetActorLocation());
-
-	TSet<FIntVector> DesiredCoords;
+	const FIntVector CenterCoord = WorldToChunkCoord(PlayerPawn->GetActorLocation());
+	const FIntVector Radius = GetStreamingRadius();
 
-	for (int x = -DrawDistance; x <= DrawDistance; ++x)
+	const auto EnqueueIfMissing = [this](const FIntVector& Coord)
 	{
-		for (int y = -DrawDistance; y <= DrawDistance; ++y)
+		if (!ChunkRegistry.Contains(Coord) && !PendingGeneration.Contains(Coord))
 		{
-			for (int z = GenerationType == EGenerationType::GT_3D ? -DrawDistance : 0;
-				 z <= (GenerationType == EGenerationType::GT_3D ? DrawDistance : 0); ++z)
+			LoadQueue.Add({Coord, 0.0f});
+		}
+	};
+
+	// Only the strips entering and leaving range change when the player crosses into another chunk
+	if (!StreamingCenter.IsSet())
+	{
+		ForEachCoordInBox(CenterCoord - Radius, CenterCoord + Radius, EnqueueIfMissing);
+	}
+	else if (CenterCoord != StreamingCenter.GetValue())
+	{
+		const FIntVector OldCenter = StreamingCenter.GetValue();
+
+		// Unfinished jobs are simply dropped, loaded chunks are unloaded a few at a time from the queue
+		ForEachCoordInDifference(OldCenter - Radius, OldCenter + Radius, CenterCoord - Radius, CenterCoord + Radius,
+			[this](const FIntVector& Coord)
 			{
-				FIntVector Coord = CenterCoord + FIntVector(x, y, z);
-				DesiredCoords.Add(Coord);
-				
-				if (!AGreedyChunk::LoadedChunks.Contains(Coord))
+				PendingGeneration.Remove(Coord);
+				if (ChunkRegistry.Contains(Coord))
 				{
-
-					SpawnChunkAt(Coord);
+					UnloadQueue.Add(Coord);
 				}
-			}
-		}
+			});
+
+		ForEachCoordInDifference(CenterCoord - Radius, CenterCoord + Radius, OldCenter - Radius, OldCenter + Radius,
+			EnqueueIfMissing);
 	}
+	StreamingCenter = CenterCoord;
 
-	// Remove out-of-range chunks
-	TArray<FIntVector> ToRemove;
-	for (const auto& Pair : AGreedyChunk::LoadedChunks)
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerPawn->GetActorEyesViewPoint(ViewLocation, ViewRotation);
+	FVector ViewDirection = ViewRotation.Vector();
+	if (GenerationType == EGenerationType::GT_2D)
 	{
+		ViewDirection = ViewDirection.GetSafeNormal2D();
+	}
+
+	// The queue only holds chunks still missing, so re-scoring it for the current view stays cheap
+	LoadQueue.RemoveAllSwap([this](const FChunkLoadRequest& Request)
+	{
+		return !IsInStreamingRange(Request.Coord);
+	}, EAllowShrinking::No);
+
+	for (FChunkLoadRequest& Request : LoadQueue)
+	{
+		Request.Priority = GetLoadPriority(Request.Coord, ViewLocation, ViewDirection);
+	}
+	LoadQueue.Heapify();
+}
 
-		if (!DesiredCoords.Contains(Pair.Key))
+FIntVector AChunkWorld::GetStreamingRadius() const
+{
+	return FIntVector(DrawDistance, DrawDistance, GenerationType == EGenerationType::GT_3D ? DrawDistance : 0);
+}
+
+bool AChunkWorld::IsInStreamingRange(const FIntVector& Coord) const
+{
+	if (!StreamingCenter.IsSet()) return false;
+
+	const FIntVector Min = StreamingCenter.GetValue() - GetStreamingRadius();
+	const FIntVector Max = StreamingCenter.GetValue() + GetStreamingRadius();
+	return Coord.X >= Min.X && Coord.Y >= Min.Y && Coord.Z >= Min.Z &&
+		   Coord.X <= Max.X && Coord.Y <= Max.Y && Coord.Z <= Max.Z;
+}
+
+void AChunkWorld::ForEachCoordInBox(const FIntVector& Min, const FIntVector& Max, const TFunctionRef<void(const FIntVector&)> Func)
+{
+	for (int z = Min.Z; z <= Max.Z; ++z)
+	{
+		for (int y = Min.Y; y <= Max.Y; ++y)
 		{
-			ToRemove.Add(Pair.Key);
+			for (int x = Min.X; x <= Max.X; ++x)
+			{
+				Func(FIntVector(x, y, z));
+			}
 		}
 	}
+}
 
-	for (const FIntVector& Coord : ToRemove)
+void AChunkWorld::ForEachCoordInDifference(
+	const FIntVector& Min, const FIntVector& Max,
+	const FIntVector& ExcludeMin, const FIntVector& ExcludeMax,
+	const TFunctionRef<void(const FIntVector&)> Func)
+{
+	FIntVector RemainingMin = Min;
+	FIntVector RemainingMax = Max;
+
+	for (int32 Axis = 0; Axis < 3; ++Axis)
 	{
-		RemoveChunkAt(Coord);
+		// Slabs of what's left of the box below and above the excluded box on this axis
+		if (RemainingMin[Axis] < ExcludeMin[Axis])
+		{
+			FIntVector SlabMax = RemainingMax;
+			SlabMax[Axis] = FMath::Min(RemainingMax[Axis], ExcludeMin[Axis] - 1);
+			ForEachCoordInBox(RemainingMin, SlabMax, Func);
+		}
+		if (RemainingMax[Axis] > ExcludeMax[Axis])
+		{
+			FIntVector SlabMin = RemainingMin;
+			SlabMin[Axis] = FMath::Max(RemainingMin[Axis], ExcludeMax[Axis] + 1);
+			ForEachCoordInBox(SlabMin, RemainingMax, Func);
+		}
+
+		// Continue with the overlap, which is empty once the boxes don't touch on an axis
+		RemainingMin[Axis] = FMath::Max(RemainingMin[Axis], ExcludeMin[Axis]);
+		RemainingMax[Axis] = FMath::Min(RemainingMax[Axis], ExcludeMax[Axis]);
+		if (RemainingMin[Axis] > RemainingMax[Axis]) return;
 	}
 }
+
 void AChunkWorld::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	// Streaming work shares one budget, whatever doesn't fit carries over to the next frame
+	const double Deadline = FPlatformTime::Seconds() + StreamingBudgetMs / 1000.0;
+	UnloadQueuedChunks(Deadline);
+	ApplyFinishedMeshes(Deadline);
+	SpawnGeneratedChunks(Deadline);
+	LaunchQueuedMeshes(Deadline);
+	ProcessLoadQueue(Deadline);
+
 	if (WaterSimulator)
 	{
 		WaterSimulator->Tick(DeltaTime);
@@ -273,24 +536,68 @@ void AChunkWorld::Tick(float DeltaTime)
 }
 void AChunkWorld::FixMeshesWhereNeighborsExist(const TArray<FIntVector>& Coords)
 {
-
-	for (const auto& Coord : Coords)
+	// Snapshotting a chunk and its neighbors isn't free, so launching waits for LaunchQueuedMeshes
+	MeshLaunchQueue.Append(Coords);
+}
+void AChunkWorld::LaunchQueuedMeshes(const double Deadline)
+{
+	for (auto It = MeshLaunchQueue.CreateIterator(); It; ++It)
 	{
-		AGreedyChunk* Chunk = AGreedyChunk::LoadedChunks.FindRef(Coord);
-		if (!Chunk) continue;
+		if (FPlatformTime::Seconds() >= Deadline) break;
+
+		const FIntVector Coord = *It;
+		It.RemoveCurrent();
+
+		AGreedyChunk* Chunk = ChunkRegistry.Find(Coord);
+		if (!Chunk || Chunk->bHasBeenMeshedWithNeighbors) continue;
 
 		bool bAllNeighborsExist =
-				AGreedyChunk::LoadedChunks.Contains(Coord + FIntVector(1, 0, 0)) &&
-				AGreedyChunk::LoadedChunks.Contains(Coord + FIntVector(-1, 0, 0)) &&
-				AGreedyChunk::LoadedChunks.Contains(Coord + FIntVector(0, 1, 0)) &&
-				AGreedyChunk::LoadedChunks.Contains(Coord + FIntVector(0, -1, 0));
+				ChunkRegistry.Contains(Coord + FIntVector(1, 0, 0)) &&
+				ChunkRegistry.Contains(Coord + FIntVector(-1, 0, 0)) &&
+				ChunkRegistry.Contains(Coord + FIntVector(0, 1, 0)) &&
+				ChunkRegistry.Contains(Coord + FIntVector(0, -1, 0)) &&
+				(GenerationType != EGenerationType::GT_3D ||
+					(ChunkRegistry.Contains(Coord + FIntVector(0, 0, 1)) && ChunkRegistry.Contains(Coord + FIntVector(0, 0, -1))));
 
 		if (bAllNeighborsExist)
 		{
 			Chunk->bShouldGenerateInitialMesh = true;
-			Chunk->UpdateMesh();
-			UE_LOG(LogTemp, Warning, TEXT("Updated mesh for chunk %d,%d,%d"), Coord.X, Coord.Y, Coord.Z);
+			Chunk->bHasBeenMeshedWithNeighbors = true;
+
+			// Replaces any older job for this chunk, its stale result is dropped
+			PendingMeshes.Add(Coord, Chunk->LaunchMeshTask());
+		}
+	}
+}
+void AChunkWorld::UnloadQueuedChunks(const double Deadline)
+{
+	for (auto It = UnloadQueue.CreateIterator(); It; ++It)
+	{
+		if (FPlatformTime::Seconds() >= Deadline) break;
+
+		const FIntVector Coord = *It;
+		It.RemoveCurrent();
+
+		// The player may have walked back into range before its turn came
+		if (!IsInStreamingRange(Coord))
+		{
+			RemoveChunkAt(Coord);
+		}
+	}
+}
+void AChunkWorld::ApplyFinishedMeshes(const double Deadline)
+{
+	for (auto It = PendingMeshes.CreateIterator(); It; ++It)
+	{
+		if (FPlatformTime::Seconds() >= Deadline) break;
+		if (!It->Value.IsCompleted()) continue;
+
+		// The chunk may have been unloaded while its mesh was being built
+		if (AGreedyChunk* Chunk = ChunkRegistry.Find(It->Key))
+		{
+			Chunk->ApplyMeshData(MoveTemp(It->Value.GetResult()));
 		}
+		It.RemoveCurrent();
 	}
 }
 void AChunkWorld::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -300,7 +607,17 @@ void AChunkWorld::EndPlay(const EEndPlayReason::Type EndPlayReason)
 		delete WaterSimulator;
 		WaterSimulator = nullptr;
 	}
-	AGreedyChunk::LoadedChunks.Empty();
+	LogGenerationTimings();
+
+	// Jobs hold their own reference to the generator, so they can be left to finish on their own
+	PendingGeneration.Empty();
+	PendingMeshes.Empty();
+	MeshLaunchQueue.Empty();
+	UnloadQueue.Empty();
+	LoadQueue.Empty();
+	ChunkPool.Empty();
+	ChunkRegistry.Empty();
+	WorldGenerator.Reset();
 
 	Super::EndPlay(EndPlayReason);
 }
\ No newline at end of file
@@ -5,11 +5,26 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 
+#include "Tasks/Task.h"
+#include "Voxel_Craft/Utils/ChunkMeshData.h"
+#include "Voxel_Craft/Utils/ChunkVoxelData.h"
 #include "Voxel_Craft/Utils/Enums.h"
 #include "Voxel_Craft/Utils/WaterSimulator.h"
+#include "Voxel_Craft/World/ChunkRegistry.h"
 #include "ChunkWorld.generated.h"
 
 class AChunkBase;
+class AGreedyChunk;
+class FVoxelWorldGenerator;
+
+// A chunk waiting to be loaded, lower priority values load first
+struct FChunkLoadRequest
+{
+	FIntVector Coord;
+	float Priority;
+
+	bool operator<(const FChunkLoadRequest& Other) const { return Priority < Other.Priority; }
+};
 
 UCLASS()
 class AChunkWorld final : public AActor
@@ -30,16 +45,48 @@ public:
 	
 	UPROPERTY(EditInstanceOnly, category = "Chunk")
 	FIntVector ChunkSize = FIntVector(16, 16, 256);
+
+	// Edge length of the cube chunks 3D worlds are built from, ChunkSize only shapes 2D columns
+	UPROPERTY(EditInstanceOnly, Category = "Chunk")
+	int32 CubicChunkSize = 16;
 	
+	// Greedy meshing engine used by greedy chunks, both produce identical quads
+	UPROPERTY(EditInstanceOnly, Category = "Chunk")
+	EMeshingAlgorithm MeshingAlgorithm = EMeshingAlgorithm::Scalar;
+
 	UPROPERTY(EditInstanceOnly, Category="Height Map")
 	EGenerationType GenerationType;
 
 	UPROPERTY(EditInstanceOnly, Category="Height Map")
 	float Frequency = 0.03f;
 
+	// Sample 2D biome heights every few blocks and interpolate the columns in between instead of sampling every column
+	UPROPERTY(EditInstanceOnly, Category="Height Map")
+	bool bCoarseHeightSampling = true;
+
+	// Blocks between 3D density samples, voxels in between are trilinearly interpolated. 1 samples every voxel
+	UPROPERTY(EditInstanceOnly, Category="Height Map")
+	int32 DensitySampleSpacing = 4;
+
+	// 2D generation stages to run, clearing one skips it for every chunk (e.g. to measure the others)
+	UPROPERTY(EditInstanceOnly, Category="Height Map", meta = (Bitmask, BitmaskEnum = "/Script/Voxel_Craft.EGenerationStage"))
+	int32 GenerationStages = static_cast<int32>(EGenerationStage::All);
+
 	UPROPERTY(EditInstanceOnly, Category = "World")
 	int32 Seed = 1337; 
 
+	// Unloaded greedy chunks kept around for reuse instead of being destroyed, extras beyond this are destroyed
+	UPROPERTY(EditInstanceOnly, Category = "World")
+	int32 MaxPooledChunks = 64;
+
+	// Game thread time per frame for unloading and spawning chunks, snapshotting them for meshing and applying finished meshes
+	UPROPERTY(EditInstanceOnly, Category = "World|Streaming")
+	float StreamingBudgetMs = 4.0f;
+
+	// Generation jobs in flight at once, the rest wait in the load queue so the closest chunks go first
+	UPROPERTY(EditInstanceOnly, Category = "World|Streaming")
+	int32 MaxConcurrentGenerationJobs = 8;
+
 	AChunkWorld();
 	
 protected:
@@ -51,27 +98,113 @@ private:
 	APawn* PlayerPawn = nullptr;
 
 	FWaterSimulator* WaterSimulator = nullptr;
-	
+
+	// Built in BeginPlay from the world settings, shared read-only by every chunk and generation job
+	TSharedPtr<const FVoxelWorldGenerator> WorldGenerator;
 
 	// Timer to periodically update chunks
 	FTimerHandle UpdateTimerHandle;
 
+	// Voxel generation jobs running on worker threads, keyed by chunk coordinate
+	TMap<FIntVector, UE::Tasks::TTask<FChunkVoxelData>> PendingGeneration;
+
+	// Greedy meshing jobs running on worker threads, keyed by chunk coordinate
+	TMap<FIntVector, UE::Tasks::TTask<TArray<FChunkMeshData>>> PendingMeshes;
+
+	// Chunks whose first mesh waits for a snapshot, launched by LaunchQueuedMeshes within the streaming budget
+	TSet<FIntVector> MeshLaunchQueue;
+
+	// Chunks that left range and wait to be removed by UnloadQueuedChunks within the streaming budget
+	TSet<FIntVector> UnloadQueue;
+
+	// Missing chunks in range, a heap ordered by distance to the player and view direction
+	TArray<FChunkLoadRequest> LoadQueue;
+
+	// Center chunk of the range currently streamed in, unset until the first world is loaded
+	TOptional<FIntVector> StreamingCenter;
+
+	// Hidden, emptied chunks waiting to be reused by SpawnChunkAt
+	UPROPERTY()
+	TArray<TObjectPtr<AGreedyChunk>> ChunkPool;
+
+	// Loaded greedy chunks by coordinate, sized to the streaming range in BeginPlay
+	FChunkRegistry ChunkRegistry;
+
 	// Converts world position to chunk grid coordinate
 	FIntVector WorldToChunkCoord(const FVector& Location) const;
 
-	// Spawns a chunk at a specific chunk coordinate
-	void SpawnChunkAt(const FIntVector& Coord);
+	// Starts generating a chunk's voxels on a worker thread; the actor is spawned once they are ready
+	void QueueChunkGeneration(const FIntVector& Coord);
+
+	// Launches the generation job for a chunk coordinate
+	UE::Tasks::TTask<FChunkVoxelData> LaunchGenerationTask(const FIntVector& Coord) const;
+
+	// Logs the average time generated chunks spent in each generation stage
+	void LogGenerationTimings() const;
+
+	// Load priority of a chunk seen from the player's view point, distance in chunks scaled up for chunks behind the view
+	float GetLoadPriority(const FIntVector& Coord, const FVector& ViewLocation, const FVector& ViewDirection) const;
+
+	// Starts generation for the highest priority chunks in the load queue
+	void ProcessLoadQueue(double Deadline);
+
+	// Spawns actors for finished generation jobs until Deadline (FPlatformTime::Seconds)
+	void SpawnGeneratedChunks(double Deadline);
+
+	// Hands finished meshing jobs back to their chunks until Deadline (FPlatformTime::Seconds)
+	void ApplyFinishedMeshes(double Deadline);
+
+	// Snapshots and launches queued meshing jobs until Deadline (FPlatformTime::Seconds)
+	void LaunchQueuedMeshes(double Deadline);
+
+	// Removes queued chunks that are still out of range until Deadline (FPlatformTime::Seconds)
+	void UnloadQueuedChunks(double Deadline);
+
+	// Spawns a chunk at a specific chunk coordinate from already generated voxels, reusing a pooled one when possible
+	AChunkBase* SpawnChunkAt(const FIntVector& Coord, FChunkVoxelData&& Voxels);
+
+	// Spawns a generated chunk, or only records it in the registry when a 3D chunk is open air or buried rock
+	void AddGeneratedChunk(const FIntVector& Coord, FChunkVoxelData&& Voxels);
 
-	// Destroys and removes a chunk at a coordinate
-	static void RemoveChunkAt(const FIntVector& Coord);
+	// True when a loaded face neighbor of Coord isn't solid all the way through
+	bool HasOpenNeighbor(const FIntVector& Coord) const;
 
-	// Updates visible chunks around player
+	// Spawns actors for the elided solid chunks around Coord, once something next to them can be seen
+	void SpawnExposedNeighbors(const FIntVector& Coord);
+
+	// Coord and the neighbors whose meshes depend on it, horizontal only for 2D columns
+	TArray<FIntVector> GetChunkAndNeighbors(const FIntVector& Coord) const;
+
+	// Removes a chunk at a coordinate, returning it to the pool or destroying it
+	void RemoveChunkAt(const FIntVector& Coord);
+
+	// Parks a chunk that is out of the registry in the pool, or destroys it once the pool is full
+	void ReleaseChunk(AGreedyChunk* Chunk);
+
+	// Updates visible chunks around player, only touching the strips that enter or leave range
 	void UpdateChunks();
+
+	// Chunks streamed in on each side of the center chunk
+	FIntVector GetStreamingRadius() const;
+
+	// True when Coord is inside the range currently streamed in around StreamingCenter
+	bool IsInStreamingRange(const FIntVector& Coord) const;
+
+	// Calls Func for every coordinate in the inclusive box
+	static void ForEachCoordInBox(const FIntVector& Min, const FIntVector& Max, TFunctionRef<void(const FIntVector&)> Func);
+
+	// Calls Func for every coordinate in [Min, Max] outside [ExcludeMin, ExcludeMax], in time proportional to the difference
+	static void ForEachCoordInDifference(
+		const FIntVector& Min, const FIntVector& Max,
+		const FIntVector& ExcludeMin, const FIntVector& ExcludeMax,
+		TFunctionRef<void(const FIntVector&)> Func);
 	virtual void Tick(float DeltaTime) override;
-	static void FixMeshesWhereNeighborsExist(const TArray<FIntVector>& LoadedChunks);
+
+	// Queues Coords for their first mesh, each is launched once all its neighbors are loaded
+	void FixMeshesWhereNeighborsExist(const TArray<FIntVector>& Coords);
 
 	int ChunkCount;
-	
-	void Generate3DWorld();
-	void Generate2DWorld();
+
+	// Loads the whole streaming range around the origin before play starts
+	void GenerateWorld();
 };
\ No newline at end of file